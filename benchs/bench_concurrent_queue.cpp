@@ -0,0 +1,273 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 Victor Moncada <vtr.moncada@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <seq/concurrent_queue.hpp>
+#include <seq/format.hpp>
+#include <seq/testing.hpp>
+
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+
+using namespace seq;
+
+/// @brief std::deque protected by a std::mutex
+template<class T>
+class mutex_deque
+{
+	std::mutex d_lock;
+	std::deque<T> d_deque;
+
+public:
+	void push(const T& v)
+	{
+		std::lock_guard<std::mutex> ll(d_lock);
+		d_deque.push_back(v);
+	}
+	template<class Iter>
+	void push(Iter first, Iter last)
+	{
+		std::lock_guard<std::mutex> ll(d_lock);
+		d_deque.insert(d_deque.end(), first, last);
+	}
+	bool try_pop(T& v)
+	{
+		std::lock_guard<std::mutex> ll(d_lock);
+		if (d_deque.empty())
+			return false;
+		v = std::move(d_deque.front());
+		d_deque.pop_front();
+		return true;
+	}
+	template<class OutIter>
+	size_t try_pop(OutIter out, size_t max)
+	{
+		std::lock_guard<std::mutex> ll(d_lock);
+		size_t n = std::min(max, d_deque.size());
+		std::move(d_deque.begin(), d_deque.begin() + static_cast<std::ptrdiff_t>(n), out);
+		d_deque.erase(d_deque.begin(), d_deque.begin() + static_cast<std::ptrdiff_t>(n));
+		return n;
+	}
+};
+
+/// @brief Naive bounded ring buffer: head and tail share a cache line and are read on each operation.
+/// Multiple producers are serialized with a spinlock.
+template<class T>
+class naive_ring_buffer
+{
+	std::vector<T> d_buffer;
+	size_t d_mask;
+	std::atomic<size_t> d_head{ 0 };
+	std::atomic<size_t> d_tail{ 0 };
+	spinlock d_lock;
+
+public:
+	naive_ring_buffer(size_t capacity = 1U << 16U)
+	  : d_buffer(capacity)
+	  , d_mask(capacity - 1)
+	{
+	}
+	void push(const T& v)
+	{
+		std::lock_guard<spinlock> ll(d_lock);
+		size_t tail = d_tail.load(std::memory_order_relaxed);
+		while (tail - d_head.load(std::memory_order_acquire) == d_buffer.size())
+			std::this_thread::yield();
+		d_buffer[tail & d_mask] = v;
+		d_tail.store(tail + 1, std::memory_order_release);
+	}
+	template<class Iter>
+	void push(Iter first, Iter last)
+	{
+		for (; first != last; ++first)
+			push(*first);
+	}
+	bool try_pop(T& v)
+	{
+		size_t head = d_head.load(std::memory_order_relaxed);
+		if (head == d_tail.load(std::memory_order_acquire))
+			return false;
+		v = std::move(d_buffer[head & d_mask]);
+		d_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+	template<class OutIter>
+	size_t try_pop(OutIter out, size_t max)
+	{
+		size_t n = 0;
+		T v;
+		while (n < max && try_pop(v)) {
+			*out = std::move(v);
+			++out;
+			++n;
+		}
+		return n;
+	}
+};
+
+/// @brief Throughput of a queue with producers threads pushing count values each, and one consumer thread.
+/// Values are pushed one by one (batch == 1) or by ranges of batch values, and popped the same way.
+template<class Queue>
+size_t queue_throughput(size_t producers, size_t count, size_t batch)
+{
+	Queue q;
+	std::atomic<bool> start{ false };
+	std::vector<std::thread> threads;
+	for (size_t p = 0; p < producers; ++p)
+		threads.emplace_back([&]() {
+			std::vector<size_t> vals(batch);
+			while (!start.load())
+				std::this_thread::yield();
+			for (size_t i = 0; i < count; i += batch) {
+				if (batch == 1)
+					q.push(i);
+				else {
+					for (size_t j = 0; j < batch; ++j)
+						vals[j] = i + j;
+					q.push(vals.begin(), vals.end());
+				}
+			}
+		});
+
+	tick();
+	start.store(true);
+	size_t received = 0, sum = 0;
+	std::vector<size_t> out;
+	out.reserve(batch);
+	while (received < producers * count) {
+		size_t n = 0;
+		if (batch == 1) {
+			size_t v;
+			if (q.try_pop(v)) {
+				sum += v;
+				n = 1;
+			}
+		}
+		else {
+			out.clear();
+			n = q.try_pop(std::back_inserter(out), batch);
+			for (size_t v : out)
+				sum += v;
+		}
+		if (n == 0)
+			std::this_thread::yield();
+		received += n;
+	}
+	for (auto& t : threads)
+		t.join();
+	size_t el = tock_ms();
+	print_null(sum);
+	return el;
+}
+
+/// @brief Average round trip latency in nanoseconds: a value is pushed to a first queue, popped by another thread
+/// and pushed back to a second queue.
+template<class Queue>
+size_t queue_latency(size_t count)
+{
+	Queue q1, q2;
+	std::thread echo([&]() {
+		size_t v = 0;
+		for (size_t i = 0; i < count; ++i) {
+			while (!q1.try_pop(v))
+				std::this_thread::yield();
+			q2.push(v);
+		}
+	});
+	auto start = std::chrono::steady_clock::now();
+	size_t v = 0;
+	for (size_t i = 0; i < count; ++i) {
+		q1.push(i);
+		while (!q2.try_pop(v))
+			std::this_thread::yield();
+	}
+	auto end = std::chrono::steady_clock::now();
+	echo.join();
+	return static_cast<size_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) / count;
+}
+
+inline void test_concurrent_queues(size_t count)
+{
+	std::cout << std::endl;
+	std::cout << "Queue throughput for " << count << " values split among producers (" << std::thread::hardware_concurrency() << " threads)" << std::endl;
+	std::cout << std::endl;
+
+	std::cout << fmt(fmt("queue").l(30), "|", fmt("1 prod (ms)").c(15), "|", fmt("1 prod, x64 (ms)").c(18), "|", fmt("4 prod (ms)").c(15), "|", fmt("4 prod, x64 (ms)").c(18), "|")
+		  << std::endl;
+	std::cout << fmt(rep('-', 30), "|", rep('-', 15), "|", rep('-', 18), "|", rep('-', 15), "|", rep('-', 18), "|") << std::endl;
+	auto f = fmt(pos<0, 2, 4, 6, 8>(), str().l(30), "|", fmt(size_t()).c(15), "|", fmt(size_t()).c(18), "|", fmt(size_t()).c(15), "|", fmt(size_t()).c(18), "|");
+
+	// spsc_queue does not support several producers
+	std::cout << fmt(fmt("seq::spsc_queue").l(30),
+			 "|",
+			 fmt(queue_throughput<spsc_queue<size_t>>(1, count, 1)).c(15),
+			 "|",
+			 fmt(queue_throughput<spsc_queue<size_t>>(1, count, 64)).c(18),
+			 "|",
+			 fmt("-").c(15),
+			 "|",
+			 fmt("-").c(18),
+			 "|")
+		  << std::endl;
+	std::cout << f("seq::mpsc_queue",
+		       queue_throughput<mpsc_queue<size_t>>(1, count, 1),
+		       queue_throughput<mpsc_queue<size_t>>(1, count, 64),
+		       queue_throughput<mpsc_queue<size_t>>(4, count / 4, 1),
+		       queue_throughput<mpsc_queue<size_t>>(4, count / 4, 64))
+		  << std::endl;
+	std::cout << f("std::mutex + std::deque",
+		       queue_throughput<mutex_deque<size_t>>(1, count, 1),
+		       queue_throughput<mutex_deque<size_t>>(1, count, 64),
+		       queue_throughput<mutex_deque<size_t>>(4, count / 4, 1),
+		       queue_throughput<mutex_deque<size_t>>(4, count / 4, 64))
+		  << std::endl;
+	std::cout << f("naive ring buffer",
+		       queue_throughput<naive_ring_buffer<size_t>>(1, count, 1),
+		       queue_throughput<naive_ring_buffer<size_t>>(1, count, 64),
+		       queue_throughput<naive_ring_buffer<size_t>>(4, count / 4, 1),
+		       queue_throughput<naive_ring_buffer<size_t>>(4, count / 4, 64))
+		  << std::endl;
+
+	std::cout << std::endl;
+	std::cout << "Queue round trip latency" << std::endl;
+	std::cout << std::endl;
+	std::cout << fmt(fmt("queue").l(30), "|", fmt("round trip (ns)").c(20), "|") << std::endl;
+	std::cout << fmt(rep('-', 30), "|", rep('-', 20), "|") << std::endl;
+	const size_t trips = 200000;
+	std::cout << fmt(fmt("seq::spsc_queue").l(30), "|", fmt(queue_latency<spsc_queue<size_t>>(trips)).c(20), "|") << std::endl;
+	std::cout << fmt(fmt("seq::mpsc_queue").l(30), "|", fmt(queue_latency<mpsc_queue<size_t>>(trips)).c(20), "|") << std::endl;
+	std::cout << fmt(fmt("std::mutex + std::deque").l(30), "|", fmt(queue_latency<mutex_deque<size_t>>(trips)).c(20), "|") << std::endl;
+	std::cout << fmt(fmt("naive ring buffer").l(30), "|", fmt(queue_latency<naive_ring_buffer<size_t>>(trips)).c(20), "|") << std::endl;
+}
+
+int bench_concurrent_queue(int, char** const)
+{
+	test_concurrent_queues(20000000);
+	return 0;
+}
@@ -23,6 +23,11 @@
  */
 
 #include <unordered_set>
+#include <unordered_map>
+#include <list>
+#include <random>
+#include <thread>
+#include <execution>
 #include <iostream>
 #include <fstream>
 
@@ -44,6 +49,7 @@
 #include <seq/any.hpp>
 #include <seq/tiny_string.hpp>
 #include <seq/concurrent_map.hpp>
+#include <seq/chunk_pool.hpp>
 
 //#include "flat_hash_map.hpp"
 
@@ -408,10 +414,258 @@ void test_hash(int count, Gen gen, bool save_keys = false)
 	}
 }
 
+/// @brief Simple LRU cache based on std::list and std::unordered_map, used as reference
+template<class Key, class T>
+class std_lru
+{
+	using list_type = std::list<std::pair<Key, T>>;
+	list_type d_list;
+	std::unordered_map<Key, typename list_type::iterator> d_index;
+	size_t d_capacity;
+
+public:
+	explicit std_lru(size_t capacity)
+	  : d_capacity(capacity)
+	{
+		d_index.reserve(capacity);
+	}
+	auto size() const noexcept -> size_t { return d_list.size(); }
+	T* get(const Key& key)
+	{
+		auto it = d_index.find(key);
+		if (it == d_index.end())
+			return nullptr;
+		d_list.splice(d_list.end(), d_list, it->second);
+		return &it->second->second;
+	}
+	void insert_or_assign(const Key& key, const T& value)
+	{
+		auto it = d_index.find(key);
+		if (it != d_index.end()) {
+			it->second->second = value;
+			d_list.splice(d_list.end(), d_list, it->second);
+			return;
+		}
+		d_list.emplace_back(key, value);
+		d_index.emplace(key, std::prev(d_list.end()));
+		if (d_list.size() > d_capacity) {
+			d_index.erase(d_list.front().first);
+			d_list.pop_front();
+		}
+	}
+};
+
+template<class Lru>
+void test_lru(const char* name, Lru& lru, const std::vector<size_t>& keys)
+{
+	size_t hits = 0;
+	tick();
+	for (size_t i = 0; i < keys.size(); ++i) {
+		if (size_t* v = lru.get(keys[i])) {
+			++hits;
+			*v += 1;
+		}
+		else
+			lru.insert_or_assign(keys[i], i);
+	}
+	size_t el = tock_ms();
+	std::cout << fmt(fmt(name).l(30), "|", fmt(el, " ms").c(20), "|", fmt(static_cast<double>(hits) / static_cast<double>(keys.size())).c(20), "|", fmt(lru.size()).c(20), "|")
+		  << std::endl;
+}
+
+/// @brief Compare seq::lru_ordered_map against a std::list + std::unordered_map LRU cache.
+/// Keys follow a skewed distribution over 4 times the cache capacity.
+inline void test_lru(size_t capacity = 1000000, size_t count = 20000000)
+{
+	std::vector<size_t> keys(count);
+	std::mt19937_64 rng(0);
+	for (size_t i = 0; i < count; ++i) {
+		// square of a uniform value: small keys are more frequent
+		double u = static_cast<double>(rng() >> 11) / static_cast<double>(1ULL << 53);
+		keys[i] = static_cast<size_t>(u * u * static_cast<double>(capacity * 4));
+	}
+
+	std::cout << std::endl;
+	std::cout << "LRU cache of " << capacity << " elements, " << count << " get/insert" << std::endl;
+	std::cout << std::endl;
+	std::cout << fmt(fmt("cache").l(30), "|", fmt("time").c(20), "|", fmt("hit ratio").c(20), "|", fmt("size").c(20), "|") << std::endl;
+	std::cout << fmt(rep('-', 30), "|", rep('-', 20), "|", rep('-', 20), "|", rep('-', 20), "|") << std::endl;
+
+	{
+		std_lru<size_t, size_t> lru(capacity);
+		test_lru("std::unordered_map + list", lru, keys);
+	}
+	{
+		seq::lru_ordered_map<size_t, size_t> lru(capacity);
+		test_lru("seq::lru_ordered_map", lru, keys);
+	}
+}
+
+template<class Alloc>
+void test_small_sets(const char* name, size_t count)
+{
+	using set_type = ordered_set<size_t, seq::hasher<size_t>, std::equal_to<>, Alloc>;
+	std::vector<set_type> sets(count);
+	// Pages freed by a previous test are reused without increasing the RSS: use the pool footprint for chunk_pool_allocator
+	constexpr bool pool = std::is_same_v<Alloc, seq::chunk_pool_allocator<size_t>>;
+	size_t start_mem = pool ? seq::chunk_pool_memory_footprint() : get_memory_usage();
+
+	// Build count sets of 1 to 32 values
+	tick();
+	for (size_t i = 0; i < count; ++i) {
+		size_t size = 1 + ((i * UINT64_C(0xc4ceb9fe1a85ec53)) >> 59U);
+		for (size_t j = 0; j < size; ++j)
+			sets[i].insert(i + j * count);
+	}
+	size_t build = tock_ms();
+	size_t mem = (pool ? seq::chunk_pool_memory_footprint() : get_memory_usage()) - start_mem;
+
+	// Erase every other value, insert new ones and shrink
+	tick();
+	for (size_t i = 0; i < count; ++i) {
+		size_t size = sets[i].size();
+		for (size_t j = 0; j < size; j += 2)
+			sets[i].erase(i + j * count);
+		for (size_t j = 0; j < size; j += 4)
+			sets[i].insert(i + (j + size) * count);
+		sets[i].shrink_to_fit();
+	}
+	size_t churn = tock_ms();
+
+	tick();
+	sets.clear();
+	sets.shrink_to_fit();
+	size_t destroy = tock_ms();
+
+	std::cout << fmt(fmt(name).l(30),
+			 "|",
+			 fmt(build, " ms").c(20),
+			 "|",
+			 fmt(static_cast<size_t>(static_cast<double>(count) / (static_cast<double>(build) / 1000.))).c(20),
+			 "|",
+			 fmt(churn, " ms").c(20),
+			 "|",
+			 fmt(destroy, " ms").c(20),
+			 "|",
+			 fmt(mem / (1024 * 1024), " MB").c(20),
+			 "|")
+		  << std::endl;
+}
+
+/// @brief Compare std::allocator and seq::chunk_pool_allocator for a large number of small seq::ordered_set
+inline void test_small_sets(size_t count = 1000000)
+{
+	std::cout << std::endl;
+	std::cout << "Build, modify and destroy " << count << " seq::ordered_set<size_t> of 1 to 32 values" << std::endl;
+	std::cout << std::endl;
+	std::cout << fmt(fmt("allocator").l(30), "|", fmt("build").c(20), "|", fmt("sets/s").c(20), "|", fmt("erase/insert").c(20), "|", fmt("destroy").c(20), "|", fmt("memory").c(20), "|")
+		  << std::endl;
+	std::cout << fmt(rep('-', 30), "|", rep('-', 20), "|", rep('-', 20), "|", rep('-', 20), "|", rep('-', 20), "|", rep('-', 20), "|") << std::endl;
+	// The pool never gives back its memory: test it last
+	test_small_sets<std::allocator<size_t>>("std::allocator", count);
+	test_small_sets<seq::chunk_pool_allocator<size_t>>("seq::chunk_pool_allocator", count);
+}
+
+/// @brief Measure seq::ordered_set successful and failed lookups for several load factors.
+/// The table is kept at 2^22 buckets and filled up to the requested load factor.
+/// Build with -DSEQ_NO_SIMD_PROBE to get the scalar probing reference.
+template<class T, class Hash, class Gen>
+void test_ordered_set_lookup(const char* name, Gen gen)
+{
+#if defined(SEQ_NO_SIMD_PROBE) || !defined(__SSE2__)
+	const char* probing = "scalar";
+#elif defined(__AVX2__)
+	const char* probing = "AVX2, 4 nodes";
+#else
+	const char* probing = "SSE2, 2 nodes";
+#endif
+	const size_t buckets = 1ULL << 22U;
+	std::vector<T> keys(buckets * 2);
+	for (size_t i = 0; i < keys.size(); ++i)
+		keys[i] = static_cast<T>(gen(i));
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+	seq::random_shuffle(keys.begin(), keys.end(), 1);
+	std::vector<T> failed(keys.begin() + keys.size() / 2, keys.end());
+	keys.resize(keys.size() / 2);
+
+	std::cout << std::endl;
+	std::cout << "seq::ordered_set<" << name << "> lookup with " << buckets << " buckets (" << probing << " probing)" << std::endl;
+	std::cout << std::endl;
+	std::cout << fmt(fmt("load factor").l(30), "|", fmt("Find(success)").c(20), "|", fmt("Find(failed)").c(20), "|") << std::endl;
+	std::cout << fmt(rep('-', 30), "|", rep('-', 20), "|", rep('-', 20), "|") << std::endl;
+
+	for (double lf : { 0.3, 0.5, 0.6, 0.7, 0.85, 0.94 }) {
+		std::vector<T> success(keys.begin(), keys.begin() + static_cast<size_t>(lf * static_cast<double>(buckets)));
+		ordered_set<T, Hash, std::equal_to<>> set;
+		set.max_load_factor(0.95f);
+		set.insert(success.begin(), success.end());
+		// keep the same bucket count for all load factors
+		set.rehash(buckets);
+		seq::random_shuffle(success.begin(), success.end(), 1);
+
+		size_t sum = 0;
+		tick();
+		for (const T& k : success)
+			sum += set.count(k);
+		size_t find = tock_ms();
+		SEQ_TEST(sum == success.size());
+
+		sum = 0;
+		tick();
+		for (size_t i = 0; i < success.size(); ++i)
+			sum += set.count(failed[i]);
+		size_t find_fail = tock_ms();
+		SEQ_TEST(sum == 0);
+
+		std::cout << fmt(fmt(set.load_factor()).l(30), "|", fmt(fmt(find), " ms").c(20), "|", fmt(fmt(find_fail), " ms").c(20), "|") << std::endl;
+	}
+}
+
+/// @brief Bulk load count keys (with duplicates) through ordered_set::sequence(), and compare sequential and parallel rehash
+template<class T, class Hash, class Gen>
+void test_bulk_load(const char* name, size_t count, Gen gen)
+{
+	std::vector<T> keys(count);
+	for (size_t i = 0; i < keys.size(); ++i)
+		keys[i] = static_cast<T>(gen(i));
+
+	std::cout << std::endl;
+	std::cout << "Bulk load of " << count << " " << name << " in seq::ordered_set (" << std::thread::hardware_concurrency() << " threads)" << std::endl;
+	std::cout << std::endl;
+	std::cout << fmt(fmt("rehash").l(30), "|", fmt("load sequence").c(20), "|", fmt("rehash").c(20), "|", fmt("size").c(20), "|") << std::endl;
+	std::cout << fmt(rep('-', 30), "|", rep('-', 20), "|", rep('-', 20), "|", rep('-', 20), "|") << std::endl;
+
+	auto run = [&](const char* rname, auto&& rehash) {
+		ordered_set<T, Hash, std::equal_to<>> set;
+		tick();
+		set.sequence().assign(keys.begin(), keys.end());
+		size_t load = tock_ms();
+		tick();
+		rehash(set);
+		size_t el = tock_ms();
+		std::cout << fmt(fmt(rname).l(30), "|", fmt(fmt(load), " ms").c(20), "|", fmt(fmt(el), " ms").c(20), "|", fmt(set.size()).c(20), "|") << std::endl;
+	};
+	run("rehash()", [](auto& set) { set.rehash(); });
+	run("rehash(std::execution::seq)", [](auto& set) { set.rehash(std::execution::seq); });
+	run("rehash(std::execution::par)", [](auto& set) { set.rehash(std::execution::par); });
+}
+
 int bench_hash(int, char** const)
 {
-	
-	
+	test_small_sets(1000000);
+	test_lru(1000000, 20000000);
+
+	{
+		random_float_genertor<double> rng;
+		test_ordered_set_lookup<double, seq::hasher<double>>("double", [&rng](size_t) { return rng(); });
+		test_ordered_set_lookup<size_t, seq::hasher<size_t>>("size_t", [](size_t i) { return i * UINT64_C(0xc4ceb9fe1a85ec53); });
+		test_ordered_set_lookup<tstring, seq::hasher<tstring>>("tstring", [](size_t) { return generate_random_string<tstring>(13, true); });
+	}
+
+	test_bulk_load<size_t, seq::hasher<size_t>>("size_t", 100000000, [](size_t i) { return (i * UINT64_C(0xc4ceb9fe1a85ec53)) % 90000000U; });
+	test_bulk_load<tstring, seq::hasher<tstring>>("tstring", 20000000, [](size_t i) { return tstring(std::to_string((i * UINT64_C(0xc4ceb9fe1a85ec53)) % 18000000U).c_str()); });
+
 	test_hash<int, seq::hasher<int>>(8000000, [](size_t i) { return (i); });
 	test_hash<size_t, seq::hasher<size_t>>(8000000, [](size_t i) { return (i); });
 
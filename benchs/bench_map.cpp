@@ -397,6 +397,124 @@ void test_map(size_t count, Gen gen, Extract e = Extract())
 
 
 
+/// @brief Measure lookup speed of flat_set for arithmetic keys (SIMD bucket/lower_bound path)
+/// compared to std::lower_bound on a sorted vector.
+template<class T>
+void test_arithmetic_lookup(size_t count)
+{
+	std::vector<T> vals(count);
+	for (size_t i = 0; i < count; ++i)
+		vals[i] = static_cast<T>(i * 2);
+	seq::random_shuffle(vals.begin(), vals.end(), 1);
+
+	flat_set<T> set(vals.begin(), vals.end());
+	std::vector<T> sorted(vals.begin(), vals.end());
+	std::sort(sorted.begin(), sorted.end());
+
+	std::vector<T> probes(count);
+	for (size_t i = 0; i < count; ++i)
+		probes[i] = static_cast<T>(vals[i] + static_cast<T>(i & 1));
+
+	size_t sum = 0;
+	tick();
+	for (size_t i = 0; i < count; ++i)
+		sum += set.lower_bound_pos(probes[i]);
+	size_t flat = tock_ms();
+
+	tick();
+	for (size_t i = 0; i < count; ++i)
+		sum += static_cast<size_t>(std::lower_bound(sorted.begin(), sorted.end(), probes[i]) - sorted.begin());
+	size_t vec = tock_ms();
+
+	std::vector<size_t> pos(count);
+	tick();
+	sum += set.find_batch_pos(probes.begin(), probes.end(), pos.begin());
+	size_t batch = tock_ms();
+	print_null(sum);
+
+	std::cout << fmt(fmt(typeid(T).name()).l(10), "|", fmt(flat).c(20), "|", fmt(batch).c(20), "|", fmt(vec).c(20), "|") << std::endl;
+}
+
+void test_arithmetic_lookups(size_t count)
+{
+	std::cout << std::endl;
+	std::cout << "Test lower_bound on arithmetic keys with count = " << count << std::endl;
+	std::cout << std::endl;
+	std::cout << fmt(fmt("Type").l(10), "|", fmt("flat_set (ms)").c(20), "|", fmt("find_batch (ms)").c(20), "|", fmt("std::lower_bound (ms)").c(20), "|") << std::endl;
+	std::cout << fmt(str().l(10).f('-'), "|", str().c(20).f('-'), "|", str().c(20).f('-'), "|", str().c(20).f('-'), "|") << std::endl;
+	test_arithmetic_lookup<int>(count);
+	test_arithmetic_lookup<std::int64_t>(count);
+	test_arithmetic_lookup<double>(count);
+}
+
+/// @brief Compare flat_set set operations (galloping merge) with std::set_intersection/std::set_union on
+/// exported vectors and with a find() loop, for balanced and skewed sizes.
+inline void test_set_operation(size_t count1, size_t count2)
+{
+	std::mt19937_64 rng(0);
+	std::vector<size_t> v1(count1), v2(count2);
+	for (auto& v : v1)
+		v = rng() % (count1 * 4);
+	for (auto& v : v2)
+		v = rng() % (count1 * 4);
+	flat_set<size_t> s1(v1.begin(), v1.end());
+	flat_set<size_t> s2(v2.begin(), v2.end());
+
+	size_t sum = 0;
+	tick();
+	sum += s1.merge_intersection(s2).size();
+	size_t inter = tock_ms();
+
+	tick();
+	sum += s1.merge_union(s2).size();
+	size_t uni = tock_ms();
+
+	tick();
+	{
+		std::vector<size_t> e1(s1.begin(), s1.end()), e2(s2.begin(), s2.end()), out;
+		std::set_intersection(e1.begin(), e1.end(), e2.begin(), e2.end(), std::back_inserter(out));
+		sum += out.size();
+	}
+	size_t std_inter = tock_ms();
+
+	tick();
+	{
+		flat_set<size_t> out;
+		for (auto v : s2)
+			if (s1.contains(v))
+				out.insert(out.end(), v);
+		sum += out.size();
+	}
+	size_t find_inter = tock_ms();
+	print_null(sum);
+
+	std::cout << fmt(fmt(count1).c(10), "|", fmt(count2).c(10), "|", fmt(inter).c(20), "|", fmt(uni).c(20), "|", fmt(std_inter).c(25), "|", fmt(find_inter).c(20), "|")
+		  << std::endl;
+}
+
+inline void test_set_operations()
+{
+	std::cout << std::endl;
+	std::cout << "Test flat_set set operations" << std::endl;
+	std::cout << std::endl;
+	std::cout << fmt(fmt("Size 1").c(10),
+			 "|",
+			 fmt("Size 2").c(10),
+			 "|",
+			 fmt("intersection (ms)").c(20),
+			 "|",
+			 fmt("union (ms)").c(20),
+			 "|",
+			 fmt("std::set_intersection (ms)").c(25),
+			 "|",
+			 fmt("find loop (ms)").c(20),
+			 "|")
+		  << std::endl;
+	std::cout << fmt(str().c(10).f('-'), "|", str().c(10).f('-'), "|", str().c(20).f('-'), "|", str().c(20).f('-'), "|", str().c(25).f('-'), "|", str().c(20).f('-'), "|") << std::endl;
+	test_set_operation(1000000, 1000000);
+	test_set_operation(10000000, 100000);
+}
+
 /*
 template<class Map, class Format>
 void test_small_map_repeat(const char * name, int count, int repeat, Format f)
@@ -463,6 +581,12 @@ int bench_map(int, char** const)
 	
 	using string = tstring;
 	
+	// set operations, balanced and skewed
+	test_set_operations();
+
+	// lower_bound on arithmetic keys
+	test_arithmetic_lookups(2000000);
+
 	// test random tuple
 	{
 		std::random_device dev;
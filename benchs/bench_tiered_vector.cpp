@@ -780,11 +780,203 @@ void test_tiered_vector(size_t count = 10000000)
 	}
 }
 
+namespace growth_detail
+{
+	// live and peak bytes of the growth benchmark allocators
+	inline size_t& live_bytes()
+	{
+		static size_t bytes = 0;
+		return bytes;
+	}
+	inline size_t& peak_bytes()
+	{
+		static size_t bytes = 0;
+		return bytes;
+	}
+	inline size_t& alloc_count()
+	{
+		static size_t count = 0;
+		return count;
+	}
+	inline void add_bytes(size_t add, size_t remove)
+	{
+		if (add)
+			++alloc_count();
+		live_bytes() += add;
+		live_bytes() -= remove;
+		peak_bytes() = std::max(peak_bytes(), live_bytes());
+	}
+}
+
+template<class T>
+struct peak_std_allocator : std::allocator<T>
+{
+	template<class U>
+	struct rebind
+	{
+		using other = peak_std_allocator<U>;
+	};
+	peak_std_allocator() {}
+	template<class U>
+	peak_std_allocator(const peak_std_allocator<U>&)
+	{
+	}
+	T* allocate(size_t n)
+	{
+		T* r = std::allocator<T>::allocate(n);
+		growth_detail::add_bytes(n * sizeof(T), 0);
+		return r;
+	}
+	void deallocate(T* p, size_t n)
+	{
+		growth_detail::add_bytes(0, n * sizeof(T));
+		std::allocator<T>::deallocate(p, n);
+	}
+};
+
+template<class T>
+struct peak_mmap_allocator : seq::mmap_allocator<T>
+{
+	using base = seq::mmap_allocator<T>;
+	template<class U>
+	struct rebind
+	{
+		using other = peak_mmap_allocator<U>;
+	};
+	peak_mmap_allocator() {}
+	template<class U>
+	peak_mmap_allocator(const peak_mmap_allocator<U>&)
+	{
+	}
+	T* allocate(size_t n)
+	{
+		T* r = base::allocate(n);
+		growth_detail::add_bytes(n * sizeof(T), 0);
+		return r;
+	}
+	void deallocate(T* p, size_t n)
+	{
+		growth_detail::add_bytes(0, n * sizeof(T));
+		base::deallocate(p, n);
+	}
+	T* reallocate(T* p, size_t n, size_t& new_n)
+	{
+		// mremap never holds both blocks at once
+		T* r = base::reallocate(p, n, new_n);
+		growth_detail::add_bytes(new_n * sizeof(T), n * sizeof(T));
+		return r;
+	}
+	T* reallocate_front(T* p, size_t n, size_t& new_n)
+	{
+		T* r = base::reallocate_front(p, n, new_n);
+		if (r)
+			growth_detail::add_bytes(new_n * sizeof(T), n * sizeof(T));
+		return r;
+	}
+};
+
+template<class Alloc>
+void test_devector_growth(const char* name, size_t count, bool front)
+{
+	growth_detail::live_bytes() = growth_detail::peak_bytes() = 0;
+	seq::devector<size_t, Alloc> d;
+	seq::timer t;
+	std::uint64_t worst = 0;
+
+	tick();
+	for (size_t i = 0; i < count; ++i) {
+		bool grow = front ? d.front_capacity() == 0 : d.back_capacity() == 0;
+		if (grow)
+			t.tick();
+		if (front)
+			d.push_front(i);
+		else
+			d.push_back(i);
+		if (grow)
+			worst = std::max(worst, t.tock());
+	}
+	std::uint64_t el = tock_ms();
+
+	std::cout << fmt(fmt(name).l(30), "|", fmt(el, " ms").c(20), "|", fmt(worst / 1000000, " ms").c(20), "|", fmt(growth_detail::peak_bytes() >> 20, " MB").c(20), "|") << std::endl;
+}
+
+/// @brief Compare devector growth (push_back and push_front) with std::allocator and seq::mmap_allocator.
+/// Reports the total time, the worst growth latency and the peak allocated memory.
+/// Larger sizes (up to 16GB) can be tested with enough RAM.
+inline void test_devector_growth(size_t bytes = 1ULL << 30)
+{
+	size_t count = bytes / sizeof(size_t);
+
+	std::cout << std::endl;
+	std::cout << "Compare devector growth up to " << (bytes >> 20) << " MB with std::allocator and seq::mmap_allocator" << std::endl;
+	std::cout << std::endl;
+
+	std::cout << fmt(fmt("method").l(30), "|", fmt("total").c(20), "|", fmt("worst growth").c(20), "|", fmt("peak memory").c(20), "|") << std::endl;
+	std::cout << fmt(rep('-', 30), "|", rep('-', 20), "|", rep('-', 20), "|", rep('-', 20), "|") << std::endl;
+
+	test_devector_growth<peak_std_allocator<size_t>>("push_back std::allocator", count, false);
+	test_devector_growth<peak_mmap_allocator<size_t>>("push_back mmap_allocator", count, false);
+	test_devector_growth<peak_std_allocator<size_t>>("push_front std::allocator", count, true);
+	test_devector_growth<peak_mmap_allocator<size_t>>("push_front mmap_allocator", count, true);
+}
+
+template<class List>
+void test_small_list(const char* name, size_t count, size_t max_size)
+{
+	growth_detail::live_bytes() = growth_detail::peak_bytes() = growth_detail::alloc_count() = 0;
+	std::vector<List> lists;
+	lists.reserve(count);
+
+	tick();
+	for (size_t i = 0; i < count; ++i) {
+		lists.emplace_back();
+		List& l = lists.back();
+		size_t s = (i * 7919) % (max_size + 1);
+		for (size_t j = 0; j < s; ++j)
+			l.push_back(static_cast<typename List::value_type>(j));
+	}
+	std::uint64_t build = tock_ms();
+
+	tick();
+	size_t sum = 0;
+	for (const List& l : lists)
+		for (auto v : l)
+			sum += v;
+	std::uint64_t walk = tock_ms();
+	print_null(sum);
+
+	tick();
+	lists.clear();
+	std::uint64_t destroy = tock_ms();
+
+	std::cout << fmt(fmt(name).l(30), "|", fmt(growth_detail::alloc_count()).c(20), "|", fmt(build, " ms").c(20), "|", fmt(walk, " ms").c(20), "|", fmt(destroy, " ms").c(20), "|")
+		  << std::endl;
+}
+
+/// @brief Build count small lists of up to 7 elements with std::vector, seq::devector and seq::small_devector.
+/// Reports the number of allocations, the build time, the iteration time and the destruction time.
+inline void test_small_lists(size_t count = 10000000)
+{
+	std::cout << std::endl;
+	std::cout << "Build " << count << " small lists (0 to 7 elements)" << std::endl;
+	std::cout << std::endl;
+
+	std::cout << fmt(fmt("container").l(30), "|", fmt("allocations").c(20), "|", fmt("build").c(20), "|", fmt("iterate").c(20), "|", fmt("destroy").c(20), "|") << std::endl;
+	std::cout << fmt(rep('-', 30), "|", rep('-', 20), "|", rep('-', 20), "|", rep('-', 20), "|", rep('-', 20), "|") << std::endl;
+
+	test_small_list<std::vector<std::uint32_t, peak_std_allocator<std::uint32_t>>>("std::vector", count, 7);
+	test_small_list<seq::devector<std::uint32_t, peak_std_allocator<std::uint32_t>>>("seq::devector", count, 7);
+	test_small_list<seq::small_devector<std::uint32_t, 4, peak_std_allocator<std::uint32_t>>>("seq::small_devector<4>", count, 7);
+	test_small_list<seq::small_devector<std::uint32_t, 8, peak_std_allocator<std::uint32_t>>>("seq::small_devector<8>", count, 7);
+}
+
 int bench_tiered_vector(int, char** const)
 {
 	tick();
 	size_t e = tock_ms();
 	std::cout << e << std::endl;
+	test_devector_growth(1ULL << 30);
+	test_small_lists(10000000);
 	test_tiered_vector_algorithms<size_t>(5000000);
 	test_tiered_vector<size_t>(10000000);
 
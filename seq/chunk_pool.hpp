@@ -0,0 +1,306 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 Victor Moncada <vtr.moncada@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SEQ_CHUNK_POOL_HPP
+#define SEQ_CHUNK_POOL_HPP
+
+/** @file */
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <cstdlib>
+
+#include "bits.hpp"
+#include "lock.hpp"
+
+namespace seq
+{
+	namespace detail
+	{
+		///
+		/// Global memory pool used by seq::chunk_pool_allocator.
+		///
+		/// Blocks are grouped in size classes of 64 bytes (up to max_bytes). Each size class owns a free list
+		/// protected by a spinlock, and is refilled by carving new slabs of at least slab_bytes.
+		/// Each thread keeps a small cache of free blocks per size class, exchanged with the global free list
+		/// by batches of batch_count blocks, so most allocations and deallocations do not touch shared memory.
+		///
+		/// Slabs are never given back to the system: freed blocks are only recycled.
+		///
+		class chunk_pool
+		{
+		public:
+			static constexpr size_t block_align = 64;
+			static constexpr size_t max_bytes = 4096;
+			static constexpr size_t classes = max_bytes / block_align;
+			static constexpr size_t slab_bytes = 64 * 1024;
+			static constexpr unsigned batch_count = 32;
+
+		private:
+			struct free_block
+			{
+				free_block* next;
+			};
+			struct alignas(64) size_class
+			{
+				spinlock lock;
+				free_block* head{ nullptr };
+			};
+			// Trivially destructible thread cache, still usable after the thread_local guard destruction
+			struct thread_cache
+			{
+				free_block* head[classes];
+				unsigned count[classes];
+				bool registered;
+				bool dead;
+			};
+			// Flush the thread cache to the global free lists on thread exit
+			struct thread_guard
+			{
+				~thread_guard()
+				{
+					thread_cache& c = cache();
+					for (size_t i = 0; i < classes; ++i)
+						instance().release(i, c.head[i], c.count[i]);
+					c.dead = true;
+				}
+			};
+
+			size_class d_classes[classes];
+			std::atomic<size_t> d_reserved{ 0 };
+
+			static auto cache() noexcept -> thread_cache&
+			{
+				static thread_local thread_cache c{};
+				return c;
+			}
+			static void register_thread(thread_cache& c)
+			{
+				c.registered = true;
+				static thread_local thread_guard guard;
+				(void)guard;
+			}
+
+			// Give back count blocks starting at head (linked through next) to the global free list
+			void release(size_t cl, free_block* head, unsigned count) noexcept
+			{
+				if (!count)
+					return;
+				free_block* last = head;
+				while (last->next)
+					last = last->next;
+				std::lock_guard<spinlock> ll(d_classes[cl].lock);
+				last->next = d_classes[cl].head;
+				d_classes[cl].head = head;
+			}
+
+			// Grab up to batch_count blocks from the global free list, or carve a new slab
+			auto acquire(size_t cl, unsigned& count) -> free_block*
+			{
+				const size_t bytes = (cl + 1) * block_align;
+				{
+					std::lock_guard<spinlock> ll(d_classes[cl].lock);
+					free_block* head = d_classes[cl].head;
+					if (head) {
+						free_block* last = head;
+						count = 1;
+						while (count < batch_count && last->next) {
+							last = last->next;
+							++count;
+						}
+						d_classes[cl].head = last->next;
+						last->next = nullptr;
+						return head;
+					}
+				}
+				const size_t blocks = std::max(static_cast<size_t>(batch_count), slab_bytes / bytes);
+				char* slab = static_cast<char*>(::operator new(blocks * bytes, std::align_val_t(block_align)));
+				d_reserved.fetch_add(blocks * bytes, std::memory_order_relaxed);
+				for (size_t i = 0; i < blocks - 1; ++i)
+					reinterpret_cast<free_block*>(slab + i * bytes)->next = reinterpret_cast<free_block*>(slab + (i + 1) * bytes);
+				reinterpret_cast<free_block*>(slab + (blocks - 1) * bytes)->next = nullptr;
+				// Keep batch_count blocks, give the remaining ones to the global free list
+				free_block* last = reinterpret_cast<free_block*>(slab + (batch_count - 1) * bytes);
+				if (free_block* rest = last->next) {
+					last->next = nullptr;
+					release(cl, rest, static_cast<unsigned>(blocks - batch_count));
+				}
+				count = batch_count;
+				return reinterpret_cast<free_block*>(slab);
+			}
+
+		public:
+			static auto instance() -> chunk_pool&
+			{
+				// Never destroyed: blocks might be released by static objects destroyed after the pool
+				static chunk_pool* pool = new chunk_pool();
+				return *pool;
+			}
+
+			static constexpr auto size_class_of(size_t bytes) noexcept -> size_t { return bytes ? (bytes - 1) / block_align : 0; }
+
+			auto allocate(size_t bytes) -> void*
+			{
+				const size_t cl = size_class_of(bytes);
+				thread_cache& c = cache();
+				if (SEQ_UNLIKELY(!c.head[cl])) {
+					if (SEQ_UNLIKELY(c.dead)) {
+						// Thread is exiting: bypass the cache
+						unsigned count = 0;
+						free_block* head = acquire(cl, count);
+						release(cl, head->next, count - 1);
+						return head;
+					}
+					if (!c.registered)
+						register_thread(c);
+					c.head[cl] = acquire(cl, c.count[cl]);
+				}
+				free_block* b = c.head[cl];
+				c.head[cl] = b->next;
+				--c.count[cl];
+				return b;
+			}
+
+			void deallocate(void* p, size_t bytes) noexcept
+			{
+				const size_t cl = size_class_of(bytes);
+				thread_cache& c = cache();
+				free_block* b = static_cast<free_block*>(p);
+				if (SEQ_UNLIKELY(c.dead)) {
+					b->next = nullptr;
+					release(cl, b, 1);
+					return;
+				}
+				b->next = c.head[cl];
+				c.head[cl] = b;
+				if (SEQ_UNLIKELY(++c.count[cl] >= 2 * batch_count)) {
+					// Give back half of the cache to other threads
+					free_block* last = c.head[cl];
+					for (unsigned i = 1; i < batch_count; ++i)
+						last = last->next;
+					free_block* head = c.head[cl];
+					c.head[cl] = last->next;
+					last->next = nullptr;
+					c.count[cl] -= batch_count;
+					release(cl, head, batch_count);
+				}
+			}
+
+			// Memory reserved by the pool (all slabs) in bytes
+			auto memory_footprint() const noexcept -> size_t { return d_reserved.load(std::memory_order_relaxed); }
+		};
+	}
+
+	///
+	/// @brief Allocator sharing a global pool of small memory blocks between containers.
+	/// @tparam T object type to allocate
+	///
+	/// chunk_pool_allocator is meant to be used as the Allocator parameter of seq::sequence, seq::ordered_set and seq::ordered_map
+	/// when a program creates many small containers. Instead of one malloc call per list_chunk, chunks (and any block of
+	/// up to 4096 bytes) are taken from a global pool of 64 bytes aligned blocks:
+	///		-	Blocks are grouped in size classes of 64 bytes and carved from 64KB slabs.
+	///		-	Each thread keeps a cache of free blocks per size class, exchanged with the global pool by batches of 32 blocks.
+	///		-	Chunks released by erase(), shrink_to_fit(), clear() or the container destructor go back to the pool and are reused by
+	///			any container of any thread.
+	///
+	/// Bigger blocks (like the ordered_set bucket array of large tables) are allocated with malloc.
+	/// The pool never gives memory back to the system.
+	///
+	/// chunk_pool_allocator is stateless and all instances compare equal.
+	/// Use seq::chunk_pool_memory_footprint() to retrieve the memory reserved by the pool.
+	///
+	template<class T>
+	class chunk_pool_allocator
+	{
+		static_assert(alignof(T) <= detail::chunk_pool::block_align, "chunk_pool_allocator does not support types aligned on more than 64 bytes");
+
+	public:
+		using value_type = T;
+		using pointer = T*;
+		using const_pointer = const T*;
+		using reference = T&;
+		using const_reference = const T&;
+		using size_type = size_t;
+		using difference_type = std::ptrdiff_t;
+		using propagate_on_container_swap = std::true_type;
+		using propagate_on_container_copy_assignment = std::true_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using is_always_equal = std::true_type;
+
+		template<class U>
+		struct rebind
+		{
+			using other = chunk_pool_allocator<U>;
+		};
+
+		chunk_pool_allocator() noexcept {}
+		template<class U>
+		chunk_pool_allocator(const chunk_pool_allocator<U>& /*unused*/) noexcept
+		{
+		}
+
+		auto operator==(const chunk_pool_allocator& /*unused*/) const noexcept -> bool { return true; }
+		auto operator!=(const chunk_pool_allocator& /*unused*/) const noexcept -> bool { return false; }
+
+		auto allocate(size_t n, const void* /*unused*/) -> T* { return allocate(n); }
+		auto allocate(size_t n) -> T*
+		{
+			size_t bytes = n * sizeof(T);
+			if (bytes <= detail::chunk_pool::max_bytes)
+				return static_cast<T*>(detail::chunk_pool::instance().allocate(bytes));
+			void* p = std::malloc(bytes);
+			if (!p)
+				throw std::bad_alloc();
+			return static_cast<T*>(p);
+		}
+		void deallocate(T* p, size_t n) noexcept
+		{
+			if (!p)
+				return;
+			size_t bytes = n * sizeof(T);
+			if (bytes <= detail::chunk_pool::max_bytes)
+				detail::chunk_pool::instance().deallocate(p, bytes);
+			else
+				std::free(p);
+		}
+
+		template<class U, class... Args>
+		void construct(U* p, Args&&... args)
+		{
+			new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+		}
+		template<class U>
+		void destroy(U* p)
+		{
+			p->~U();
+		}
+	};
+
+	/// @brief Returns the memory in bytes reserved by the pool used by seq::chunk_pool_allocator
+	inline auto chunk_pool_memory_footprint() noexcept -> size_t { return detail::chunk_pool::instance().memory_footprint(); }
+}
+
+#endif
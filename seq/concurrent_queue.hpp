@@ -0,0 +1,387 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 Victor Moncada <vtr.moncada@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SEQ_CONCURRENT_QUEUE_HPP
+#define SEQ_CONCURRENT_QUEUE_HPP
+
+/** @file */
+
+#include <atomic>
+#include <mutex>
+
+#include "sequence.hpp"
+#include "lock.hpp"
+
+namespace seq
+{
+	namespace detail
+	{
+		///
+		/// Unbounded FIFO queue with a single consumer, based on the seq::sequence chunks.
+		///
+		/// Values are stored in a singly linked list of list_chunk objects (the same chunk type and allocator as seq::sequence).
+		/// The producer side appends values to the tail chunk and publishes them by incrementing the tail counter (release).
+		/// The consumer side reads values up to the last published counter (acquire), and gives back fully consumed chunks
+		/// to a lock-free free list from which the producer side allocates its new chunks.
+		///
+		/// The free list has one pusher (the consumer) and one popper at a time (the producer side, serialized by Lock),
+		/// so the pop operation does not suffer from the ABA problem.
+		///
+		/// Producer and consumer states are stored in different cache lines.
+		///
+		template<class T, class Allocator, class Lock>
+		class chunk_queue
+		{
+			using chunk_type = list_chunk<T>;
+			using layout_manager = std_alloc<T, Allocator, false>;
+			static constexpr size_t count = chunk_type::count;
+
+		public:
+			using value_type = T;
+			using reference = T&;
+			using const_reference = const T&;
+			using size_type = size_t;
+			using allocator_type = Allocator;
+
+		private:
+			// Producer side
+			struct alignas(64) Producer
+			{
+				chunk_type* chunk;
+				size_t pos;
+				size_t tail;
+				Lock lock;
+			};
+			// Consumer side
+			struct alignas(64) Consumer
+			{
+				chunk_type* chunk;
+				size_t pos;
+				size_t head;
+				size_t cached_tail;
+			};
+
+			Producer d_prod;
+			// Number of published values
+			alignas(64) std::atomic<size_t> d_tail;
+			Consumer d_cons;
+			// Number of consumed values, only used by size()
+			alignas(64) std::atomic<size_t> d_head;
+			// Free list of recycled chunks (linked through next_free)
+			alignas(64) std::atomic<chunk_type*> d_free;
+			layout_manager d_alloc;
+
+			static SEQ_ALWAYS_INLINE chunk_type* next_of(chunk_type* c) noexcept { return static_cast<chunk_type*>(c->next); }
+
+			// Recycle a fully consumed chunk (consumer side)
+			void recycle(chunk_type* c) noexcept
+			{
+				chunk_type* head = d_free.load(std::memory_order_relaxed);
+				do {
+					c->next_free = head;
+				} while (!d_free.compare_exchange_weak(head, c, std::memory_order_release, std::memory_order_relaxed));
+			}
+
+			// Get a chunk from the free list or allocate a new one (producer side, locked)
+			chunk_type* make_chunk()
+			{
+				chunk_type* c = d_free.load(std::memory_order_acquire);
+				while (c && !d_free.compare_exchange_weak(c, static_cast<chunk_type*>(c->next_free), std::memory_order_acquire, std::memory_order_acquire))
+					;
+				if (!c)
+					c = d_alloc.allocate_chunk();
+				c->next = nullptr;
+				return c;
+			}
+
+			// Make sure the tail chunk has room for at least one value (producer side, locked)
+			SEQ_ALWAYS_INLINE void ensure_room()
+			{
+				if (SEQ_UNLIKELY(d_prod.pos == count)) {
+					chunk_type* c = make_chunk();
+					d_prod.chunk->next = c;
+					d_prod.chunk = c;
+					d_prod.pos = 0;
+				}
+			}
+
+			// Move the consumer to the next chunk and recycle the previous one
+			SEQ_ALWAYS_INLINE void next_head_chunk() noexcept
+			{
+				chunk_type* c = d_cons.chunk;
+				d_cons.chunk = next_of(c);
+				d_cons.pos = 0;
+				recycle(c);
+			}
+
+			// Number of values available to the consumer
+			SEQ_ALWAYS_INLINE size_t available() noexcept
+			{
+				if (d_cons.cached_tail == d_cons.head)
+					d_cons.cached_tail = d_tail.load(std::memory_order_acquire);
+				return d_cons.cached_tail - d_cons.head;
+			}
+
+			template<class... Args>
+			SEQ_ALWAYS_INLINE void emplace_no_lock(Args&&... args)
+			{
+				ensure_room();
+				construct_ptr(d_prod.chunk->buffer() + d_prod.pos, std::forward<Args>(args)...);
+				++d_prod.pos;
+				d_tail.store(++d_prod.tail, std::memory_order_release);
+			}
+
+		public:
+			chunk_queue(const Allocator& al = Allocator())
+			  : d_tail(0)
+			  , d_head(0)
+			  , d_free(nullptr)
+			  , d_alloc(al)
+			{
+				chunk_type* c = d_alloc.allocate_chunk();
+				c->next = nullptr;
+				d_prod.chunk = d_cons.chunk = c;
+				d_prod.pos = d_cons.pos = 0;
+				d_prod.tail = d_cons.head = d_cons.cached_tail = 0;
+			}
+			chunk_queue(const chunk_queue&) = delete;
+			chunk_queue& operator=(const chunk_queue&) = delete;
+
+			~chunk_queue()
+			{
+				// Destroy remaining values
+				size_t remaining = d_tail.load(std::memory_order_acquire) - d_cons.head;
+				chunk_type* c = d_cons.chunk;
+				size_t pos = d_cons.pos;
+				if constexpr (!std::is_trivially_destructible_v<T>) {
+					for (; remaining; --remaining) {
+						if (pos == count) {
+							c = next_of(c);
+							pos = 0;
+						}
+						destroy_ptr(c->buffer() + pos++);
+					}
+				}
+				// Free chunks
+				for (c = d_cons.chunk; c;) {
+					chunk_type* next = next_of(c);
+					d_alloc.deallocate_chunk(c);
+					c = next;
+				}
+				for (c = d_free.load(std::memory_order_acquire); c;) {
+					chunk_type* next = static_cast<chunk_type*>(c->next_free);
+					d_alloc.deallocate_chunk(c);
+					c = next;
+				}
+			}
+
+			/// @brief Returns the allocator associated with the queue
+			auto get_allocator() const noexcept -> allocator_type { return d_alloc.get_allocator(); }
+
+			/// @brief Returns the number of values in the queue.
+			/// The result is only an approximation if called while other threads push or pop values.
+			auto size() const noexcept -> size_type
+			{
+				size_t head = d_head.load(std::memory_order_acquire);
+				return d_tail.load(std::memory_order_acquire) - head;
+			}
+			/// @brief Returns true if the queue is empty (approximation if called concurrently)
+			auto empty() const noexcept -> bool { return size() == 0; }
+
+			/// @brief Construct a value at the back of the queue
+			template<class... Args>
+			void emplace(Args&&... args)
+			{
+				std::lock_guard<Lock> ll(d_prod.lock);
+				emplace_no_lock(std::forward<Args>(args)...);
+			}
+			void push(const T& value) { emplace(value); }
+			void push(T&& value) { emplace(std::move(value)); }
+
+			/// @brief Push the range [first, last) at the back of the queue.
+			/// Values are published chunk by chunk: the consumer sees at most one tail update for each chunk.
+			/// For mpsc_queue, the whole range is pushed in one locked section and is therefore contiguous in the queue.
+			template<class Iter>
+			void push(Iter first, Iter last)
+			{
+				std::lock_guard<Lock> ll(d_prod.lock);
+				while (first != last) {
+					ensure_room();
+					T* buf = d_prod.chunk->buffer();
+					size_t pos = d_prod.pos;
+					try {
+						for (; pos != count && first != last; ++pos, ++first)
+							construct_ptr(buf + pos, *first);
+					}
+					catch (...) {
+						d_prod.tail += pos - d_prod.pos;
+						d_prod.pos = pos;
+						d_tail.store(d_prod.tail, std::memory_order_release);
+						throw;
+					}
+					d_prod.tail += pos - d_prod.pos;
+					d_prod.pos = pos;
+					d_tail.store(d_prod.tail, std::memory_order_release);
+				}
+			}
+
+			/// @brief Pop the front value into \a value.
+			/// Returns false if the queue is empty.
+			/// Must be called by the consumer thread only.
+			bool try_pop(T& value)
+			{
+				if (!available())
+					return false;
+				if (d_cons.pos == count)
+					next_head_chunk();
+				T* p = d_cons.chunk->buffer() + d_cons.pos;
+				value = std::move(*p);
+				destroy_ptr(p);
+				++d_cons.pos;
+				d_head.store(++d_cons.head, std::memory_order_relaxed);
+				return true;
+			}
+
+			/// @brief Pop up to \a max values and write them to the output iterator \a out.
+			/// Returns the number of popped values.
+			/// The published tail is read only once, and whole chunks are consumed at a time.
+			/// Must be called by the consumer thread only.
+			template<class OutIter>
+			size_t try_pop(OutIter out, size_t max)
+			{
+				size_t n = std::min(available(), max);
+				size_t rem = n;
+				try {
+					while (rem) {
+						if (d_cons.pos == count)
+							next_head_chunk();
+						T* buf = d_cons.chunk->buffer();
+						size_t end = std::min(count, d_cons.pos + rem);
+						for (; d_cons.pos != end; ++d_cons.pos, --rem) {
+							*out = std::move(buf[d_cons.pos]);
+							++out;
+							destroy_ptr(buf + d_cons.pos);
+						}
+					}
+				}
+				catch (...) {
+					d_cons.head += n - rem;
+					d_head.store(d_cons.head, std::memory_order_relaxed);
+					throw;
+				}
+				d_cons.head += n;
+				d_head.store(d_cons.head, std::memory_order_relaxed);
+				return n;
+			}
+
+			/// @brief Call \a fun on each available value (up to \a max values) in FIFO order and pop them.
+			/// Values are processed in place, without intermediate move.
+			/// Returns the number of popped values.
+			/// Must be called by the consumer thread only.
+			template<class Fun>
+			size_t consume(Fun&& fun, size_t max = static_cast<size_t>(-1))
+			{
+				size_t n = std::min(available(), max);
+				size_t rem = n;
+				try {
+					while (rem) {
+						if (d_cons.pos == count)
+							next_head_chunk();
+						T* buf = d_cons.chunk->buffer();
+						size_t end = std::min(count, d_cons.pos + rem);
+						for (; d_cons.pos != end; ++d_cons.pos, --rem) {
+							// If fun throws, the value is still popped
+							struct Destroy
+							{
+								T* p;
+								~Destroy() { destroy_ptr(p); }
+							} d{ buf + d_cons.pos };
+							fun(buf[d_cons.pos]);
+						}
+					}
+				}
+				catch (...) {
+					// pos was not incremented for the value that threw
+					++d_cons.pos;
+					--rem;
+					d_cons.head += n - rem;
+					d_head.store(d_cons.head, std::memory_order_relaxed);
+					throw;
+				}
+				d_cons.head += n;
+				d_head.store(d_cons.head, std::memory_order_relaxed);
+				return n;
+			}
+		};
+	}
+
+	///
+	/// @brief Unbounded single-producer/single-consumer FIFO queue.
+	/// @tparam T value type
+	/// @tparam Allocator allocator type
+	///
+	/// spsc_queue stores its values in the same chunks as seq::sequence (up to 64 values per chunk) using the same chunk allocator.
+	/// Fully consumed chunks are recycled through a lock-free free list, so a queue in steady state does not allocate memory.
+	/// The memory footprint is bounded by the maximum number of values ever stored in the queue.
+	///
+	/// One thread can call push(), emplace() or push(first, last) while another thread calls try_pop() or consume().
+	/// Batched members push(first, last), try_pop(out, max) and consume() publish or read the shared counters once per chunk.
+	///
+	/// Producer state, consumer state and the shared counters live in separate cache lines to avoid false sharing.
+	///
+	template<class T, class Allocator = std::allocator<T>>
+	class spsc_queue : public detail::chunk_queue<T, Allocator, null_lock>
+	{
+		using base_type = detail::chunk_queue<T, Allocator, null_lock>;
+
+	public:
+		spsc_queue(const Allocator& al = Allocator())
+		  : base_type(al)
+		{
+		}
+	};
+
+	///
+	/// @brief Unbounded multi-producer/single-consumer FIFO queue.
+	/// @tparam T value type
+	/// @tparam Allocator allocator type
+	///
+	/// mpsc_queue shares the layout of seq::spsc_queue, but producers are serialized with a seq::spinlock.
+	/// The consumer side never takes the lock and only synchronizes with the published tail counter.
+	/// Pushing a range with push(first, last) takes the lock once, and the range is stored contiguously in the queue.
+	///
+	template<class T, class Allocator = std::allocator<T>>
+	class mpsc_queue : public detail::chunk_queue<T, Allocator, spinlock>
+	{
+		using base_type = detail::chunk_queue<T, Allocator, spinlock>;
+
+	public:
+		mpsc_queue(const Allocator& al = Allocator())
+		  : base_type(al)
+		{
+		}
+	};
+}
+
+#endif
@@ -43,6 +43,8 @@ namespace seq
 			// internal devector implementation
 
 			static constexpr bool relocatable = is_relocatable<T>::value;
+			// grow storage with Allocator::reallocate() and Allocator::reallocate_front() (see seq::mmap_allocator)
+			static constexpr bool use_reallocate = relocatable && has_reallocate<Allocator>::value;
 
 			T* data;	 // pointer to the memory storage
 			T* start;	 // pointer to the first value
@@ -173,6 +175,37 @@ namespace seq
 				}
 			}
 
+			void remap_back(size_t new_capacity)
+			{
+				// Grow storage to new_capacity using Allocator::reallocate(), keeping the front capacity.
+				// Strong exception guarantee
+				size_t size = static_cast<size_t>(end - start);
+				size_t offset = static_cast<size_t>(start - data);
+				data = get_allocator().reallocate(data, capacity, new_capacity);
+				start = data + offset;
+				end = start + size;
+				capacity = new_capacity;
+			}
+
+			void remap_front(size_t new_capacity)
+			{
+				// Grow storage to new_capacity using Allocator::reallocate_front(), keeping the back capacity.
+				// Falls back to a copy if the allocator cannot remap the block.
+				// Strong exception guarantee
+				size_t size = static_cast<size_t>(end - start);
+				size_t back = static_cast<size_t>((data + capacity) - end);
+				T* _new = get_allocator().reallocate_front(data, capacity, new_capacity);
+				if (!_new) {
+					_new = allocate(new_capacity);
+					copy_destroy_input(start, end, _new + (new_capacity - back - size));
+					deallocate(data, capacity);
+				}
+				data = _new;
+				capacity = new_capacity;
+				end = data + capacity - back;
+				start = end - size;
+			}
+
 			auto grow_capacity() const -> size_t
 			{
 				size_t c = static_cast<size_t>(static_cast<double>(capacity) * SEQ_GROW_FACTOR);
@@ -292,6 +325,9 @@ namespace seq
 				if (new_capacity <= capacity)
 					return;
 
+				if constexpr (use_reallocate)
+					return remap_back(new_capacity);
+
 				size_t size = static_cast<size_t>(end - start);
 				T* _new = allocate(new_capacity);
 				T* _new_start = _new + (start - data); // keep previous left position
@@ -332,6 +368,14 @@ namespace seq
 					start = _new_start;
 					end = start + size;
 				}
+				else if constexpr (use_reallocate) {
+					// move data to the front, then grow in place
+					if (start != data)
+						memmove(static_cast<void*>(data), static_cast<void*>(start), size * sizeof(T));
+					start = data;
+					end = data + size;
+					remap_back(required_capacity);
+				}
 				else {
 					T* _new = allocate(required_capacity);
 					try {
@@ -366,6 +410,10 @@ namespace seq
 					start = _new_start;
 					end = start + size;
 				}
+				else if constexpr (use_reallocate) {
+					// grow at the front only, keeping the back capacity
+					remap_front(capacity + (new_front_capacity - front_capacity));
+				}
 				else {
 					T* _new = allocate(required_capacity);
 					T* _new_start = _new + new_front_capacity;
@@ -487,6 +535,8 @@ namespace seq
 							deallocate(_new, _new_capacity);
 							throw;
 						}
+						deallocate(data, capacity);
+
 						data = _new;
 						start = _new_start;
 						end = _new_end;
@@ -522,6 +572,21 @@ namespace seq
 					return;
 				}
 
+				if constexpr (use_reallocate) {
+					// build the new value first, as args might reference an element of this devector
+					alignas(T) unsigned char tmp[sizeof(T)];
+					T* val = new (tmp) T(std::forward<Args>(args)...);
+					try {
+						remap_back(grow_capacity());
+					}
+					catch (...) {
+						destroy_ptr(val);
+						throw;
+					}
+					memcpy(static_cast<void*>(end), static_cast<void*>(tmp), sizeof(T));
+					return;
+				}
+
 				// reallocate
 				size_t new_capacity = grow_capacity();
 				T* _new = allocate(new_capacity);
@@ -575,6 +640,21 @@ namespace seq
 					construct_ptr(start-1, std::forward<Args>(args)...);
 					return;
 				}
+
+				if constexpr (use_reallocate) {
+					// build the new value first, as args might reference an element of this devector
+					alignas(T) unsigned char tmp[sizeof(T)];
+					T* val = new (tmp) T(std::forward<Args>(args)...);
+					try {
+						remap_front(grow_capacity());
+					}
+					catch (...) {
+						destroy_ptr(val);
+						throw;
+					}
+					memcpy(static_cast<void*>(start - 1), static_cast<void*>(tmp), sizeof(T));
+					return;
+				}
 				
 				// reallocate
 				size_t new_capacity = grow_capacity();
@@ -1219,5 +1299,543 @@ namespace seq
 	{
 	};
 
+	/// @brief Double-ending vector storing up to N elements inline.
+	/// @tparam T value type
+	/// @tparam N number of elements stored inline before allocating
+	/// @tparam Allocator allocator type
+	///
+	/// seq::small_devector provides the same interface as seq::devector, but stores up to N elements
+	/// within the object itself, like boost::small_vector. A heap buffer is only allocated when the container grows beyond N elements,
+	/// and shrink_to_fit() moves the elements back to the inline storage when possible.
+	///
+	/// The elements position is stored as offsets instead of pointers, so that seq::small_devector is relocatable
+	/// as long as T is relocatable: it can be stored in seq::tiered_vector, seq::flat_map or seq::devector without
+	/// allocation and without calling its move constructor on reallocation.
+	///
+	/// Almost all members provide basic exception guarantee.
+	/// References and iterators are invalidated by insertion/removal of elements, and by a move or a swap if the elements are stored inline.
+	///
+	template<class T, size_t N, class Allocator = std::allocator<T>>
+	class small_devector : private Allocator
+	{
+		static_assert(N > 0, "small_devector inline capacity must be greater than 0");
+		static constexpr bool relocatable = is_relocatable<T>::value;
+
+		T* d_heap;	   // heap storage, null if values are stored inline
+		size_t d_capacity; // storage capacity (N for inline storage)
+		size_t d_start;	   // offset of the first value
+		size_t d_size;	   // number of values
+		alignas(T) unsigned char d_inline[N * sizeof(T)];
+
+		SEQ_ALWAYS_INLINE auto storage() noexcept -> T* { return d_heap ? d_heap : reinterpret_cast<T*>(d_inline); }
+		SEQ_ALWAYS_INLINE auto storage() const noexcept -> const T* { return d_heap ? d_heap : reinterpret_cast<const T*>(d_inline); }
+
+		auto allocate(size_t n) -> T* { return std::allocator_traits<Allocator>::allocate(get_allocator(), n); }
+		void deallocate(T* p, size_t n) noexcept
+		{
+			if (p)
+				std::allocator_traits<Allocator>::deallocate(get_allocator(), p, n);
+		}
+
+		static void relocate(T* first, size_t n, T* dst)
+		{
+			// Move n values from first to (possibly overlapping) dst, and destroy the input
+			if (first == dst || n == 0)
+				return;
+			if constexpr (relocatable)
+				memmove(static_cast<void*>(dst), static_cast<void*>(first), n * sizeof(T));
+			else if (dst < first) {
+				for (size_t i = 0; i != n; ++i) {
+					construct_ptr(dst + i, std::move(first[i]));
+					destroy_ptr(first + i);
+				}
+			}
+			else {
+				for (size_t i = n; i-- != 0;) {
+					construct_ptr(dst + i, std::move(first[i]));
+					destroy_ptr(first + i);
+				}
+			}
+		}
+
+		auto grow_capacity() const noexcept -> size_t
+		{
+			size_t c = static_cast<size_t>(static_cast<double>(d_capacity) * SEQ_GROW_FACTOR);
+			return c <= d_capacity ? d_capacity + 1 : c;
+		}
+
+		void move_storage(size_t new_capacity, size_t new_start)
+		{
+			// Move values to a new heap buffer (or to the inline storage if new_capacity == N)
+			// at offset new_start, and release the previous buffer
+			T* _new = new_capacity == N ? reinterpret_cast<T*>(d_inline) : allocate(new_capacity);
+			if (_new == storage())
+				return;
+			relocate(storage() + d_start, d_size, _new + new_start);
+			deallocate(d_heap, d_capacity);
+			d_heap = new_capacity == N ? nullptr : _new;
+			d_capacity = new_capacity;
+			d_start = new_start;
+		}
+
+		void make_room_back()
+		{
+			// Ensure back capacity is at least 1.
+			// Values are centered within the storage if the free space is greater than the size, or if it is inline.
+			size_t free = d_capacity - d_size;
+			if (d_start > d_size || (!d_heap && free)) {
+				relocate(begin(), d_size, storage() + free / 2);
+				d_start = free / 2;
+			}
+			else
+				move_storage(grow_capacity(), d_start);
+		}
+		void make_room_front()
+		{
+			// Ensure front capacity is at least 1
+			size_t free = d_capacity - d_size;
+			size_t back = free - d_start;
+			if (back > d_size || (!d_heap && free)) {
+				relocate(begin(), d_size, storage() + (free + 1) / 2);
+				d_start = (free + 1) / 2;
+			}
+			else {
+				size_t new_capacity = grow_capacity();
+				move_storage(new_capacity, new_capacity - d_size - back);
+			}
+		}
+
+		void steal(small_devector& other)
+		{
+			// Take other content, this container must be empty without heap buffer
+			if (other.d_heap) {
+				d_heap = other.d_heap;
+				d_capacity = other.d_capacity;
+				other.d_heap = nullptr;
+				other.d_capacity = N;
+			}
+			else
+				relocate(other.storage() + other.d_start, other.d_size, storage() + other.d_start);
+			d_start = other.d_start;
+			d_size = other.d_size;
+			other.d_start = other.d_size = 0;
+		}
+
+	public:
+		using value_type = T;
+		using allocator_type = Allocator;
+		using size_type = size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = T&;
+		using const_reference = const T&;
+		using pointer = T*;
+		using const_pointer = const T*;
+		using iterator = T*;
+		using const_iterator = const T*;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+		/// @brief Number of elements stored inline
+		static constexpr size_t inline_capacity = N;
+
+		/// @brief Constructs an empty container with the given allocator alloc.
+		explicit small_devector(const Allocator& alloc = Allocator()) noexcept
+		  : Allocator(alloc)
+		  , d_heap(nullptr)
+		  , d_capacity(N)
+		  , d_start(0)
+		  , d_size(0)
+		{
+		}
+		/// @brief Constructs the container with count copies of elements with value value.
+		small_devector(size_type count, const T& value, const Allocator& alloc = Allocator())
+		  : small_devector(alloc)
+		{
+			resize(count, value);
+		}
+		/// @brief Constructs the container with count element default constructed.
+		explicit small_devector(size_type count, const Allocator& alloc = Allocator())
+		  : small_devector(alloc)
+		{
+			resize(count);
+		}
+		/// @brief Constructs the container with the contents of the range [first, last).
+		template<class InputIt, class = std::enable_if_t<!std::is_integral_v<InputIt>>>
+		small_devector(InputIt first, InputIt last, const Allocator& alloc = Allocator())
+		  : small_devector(alloc)
+		{
+			assign(first, last);
+		}
+		/// @brief Constructs the container with the contents of the initializer list init
+		small_devector(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+		  : small_devector(alloc)
+		{
+			assign(init.begin(), init.end());
+		}
+		/// @brief Copy constructor
+		small_devector(const small_devector& other)
+		  : small_devector(copy_allocator(other.get_allocator()))
+		{
+			assign(other.begin(), other.end());
+		}
+		/// @brief Copy constructor with allocator
+		small_devector(const small_devector& other, const Allocator& alloc)
+		  : small_devector(alloc)
+		{
+			assign(other.begin(), other.end());
+		}
+		/// @brief Move constructor.
+		/// Only steals the heap buffer if values are not stored inline.
+		small_devector(small_devector&& other) noexcept(relocatable || std::is_nothrow_move_constructible_v<T>)
+		  : small_devector(other.get_allocator())
+		{
+			steal(other);
+		}
+		/// @brief Move constructor with allocator
+		small_devector(small_devector&& other, const Allocator& alloc)
+		  : small_devector(alloc)
+		{
+			if (alloc == other.get_allocator())
+				steal(other);
+			else {
+				reserve(other.size());
+				for (T& v : other)
+					emplace_back(std::move(v));
+				other.clear();
+			}
+		}
+
+		~small_devector()
+		{
+			clear();
+			deallocate(d_heap, d_capacity);
+		}
+
+		/// @brief Copy operator
+		auto operator=(const small_devector& other) -> small_devector&
+		{
+			if (this != std::addressof(other)) {
+				if constexpr (assign_alloc<Allocator>::value) {
+					if (get_allocator() != other.get_allocator()) {
+						clear();
+						shrink_to_fit();
+					}
+				}
+				assign_allocator(get_allocator(), other.get_allocator());
+				assign(other.begin(), other.end());
+			}
+			return *this;
+		}
+		/// @brief Move assignment operator
+		auto operator=(small_devector&& other) -> small_devector&
+		{
+			if (this != std::addressof(other)) {
+				clear();
+				if (is_always_equal<Allocator>::value || get_allocator() == other.get_allocator() ||
+				    std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value) {
+					deallocate(d_heap, d_capacity);
+					d_heap = nullptr;
+					d_capacity = N;
+					d_start = 0;
+					move_allocator(get_allocator(), other.get_allocator());
+					steal(other);
+				}
+				else {
+					for (T& v : other)
+						emplace_back(std::move(v));
+					other.clear();
+				}
+			}
+			return *this;
+		}
+
+		/// @brief Swap this container with other
+		void swap(small_devector& other)
+		{
+			if (this != std::addressof(other)) {
+				small_devector tmp = std::move(other);
+				other = std::move(*this);
+				*this = std::move(tmp);
+			}
+		}
+
+		/// @brief Returns the container size
+		SEQ_ALWAYS_INLINE auto size() const noexcept -> size_t { return d_size; }
+		/// @brief Returns the container full capacity (back_capacity() + size() + front_capacity())
+		SEQ_ALWAYS_INLINE auto capacity() const noexcept -> size_t { return d_capacity; }
+		/// @brief Returns the container back capacity
+		SEQ_ALWAYS_INLINE auto back_capacity() const noexcept -> size_t { return d_capacity - d_size - d_start; }
+		/// @brief Returns the container front capacity
+		SEQ_ALWAYS_INLINE auto front_capacity() const noexcept -> size_t { return d_start; }
+		/// @brief Returns the container maximum size
+		SEQ_ALWAYS_INLINE auto max_size() const noexcept -> size_t { return std::numeric_limits<size_t>::max(); }
+		/// @brief Returns true if the container is empty, false otherwise
+		SEQ_ALWAYS_INLINE auto empty() const noexcept -> bool { return d_size == 0; }
+		/// @brief Returns true if the values are stored inline
+		SEQ_ALWAYS_INLINE auto is_inline() const noexcept -> bool { return d_heap == nullptr; }
+		/// @brief Returns the container allocator object
+		SEQ_ALWAYS_INLINE auto get_allocator() noexcept -> Allocator& { return *this; }
+		/// @brief Returns the container allocator object
+		SEQ_ALWAYS_INLINE auto get_allocator() const noexcept -> const Allocator& { return *this; }
+
+		/// @brief Clear the container, but does not deallocate the storage
+		void clear() noexcept
+		{
+			if constexpr (!std::is_trivially_destructible_v<T>) {
+				for (T* p = begin(); p != end(); ++p)
+					destroy_ptr(p);
+			}
+			d_start = d_size = 0;
+		}
+		/// @brief Requests the removal of unused capacity.
+		/// Values are moved back to the inline storage if size() <= N.
+		void shrink_to_fit()
+		{
+			if (d_heap && d_size != d_capacity)
+				move_storage(d_size <= N ? N : d_size, 0);
+		}
+		/// @brief Increase the capacity of the container to a value that's greater or equal to new_cap.
+		void reserve(size_t new_cap)
+		{
+			if (new_cap > d_capacity)
+				move_storage(new_cap, d_start);
+		}
+		/// @brief Ensure that the container has at least new_back_capacity free slots at the back.
+		void reserve_back(size_t new_back_capacity)
+		{
+			if (back_capacity() >= new_back_capacity)
+				return;
+			if (d_size + new_back_capacity <= d_capacity) {
+				relocate(begin(), d_size, storage() + d_capacity - d_size - new_back_capacity);
+				d_start = d_capacity - d_size - new_back_capacity;
+			}
+			else
+				move_storage(d_size + new_back_capacity, 0);
+		}
+		/// @brief Ensure that the container has at least new_front_capacity free slots at the front.
+		void reserve_front(size_t new_front_capacity)
+		{
+			if (front_capacity() >= new_front_capacity)
+				return;
+			if (d_size + new_front_capacity <= d_capacity) {
+				relocate(begin(), d_size, storage() + new_front_capacity);
+				d_start = new_front_capacity;
+			}
+			else
+				move_storage(d_size + new_front_capacity, new_front_capacity);
+		}
+
+		/// @brief Appends a new element to the end of the container.
+		/// The arguments args... may directly or indirectly refer to a value in the container.
+		template<class... Args>
+		SEQ_ALWAYS_INLINE auto emplace_back(Args&&... args) -> reference
+		{
+			if SEQ_UNLIKELY (back_capacity() == 0) {
+				T tmp(std::forward<Args>(args)...); // handle aliasing
+				make_room_back();
+				construct_ptr(end(), std::move(tmp));
+			}
+			else
+				construct_ptr(end(), std::forward<Args>(args)...);
+			++d_size;
+			return back();
+		}
+		/// @brief Appends a new element to the front of the container.
+		/// The arguments args... may directly or indirectly refer to a value in the container.
+		template<class... Args>
+		SEQ_ALWAYS_INLINE auto emplace_front(Args&&... args) -> reference
+		{
+			if SEQ_UNLIKELY (d_start == 0) {
+				T tmp(std::forward<Args>(args)...); // handle aliasing
+				make_room_front();
+				construct_ptr(begin() - 1, std::move(tmp));
+			}
+			else
+				construct_ptr(begin() - 1, std::forward<Args>(args)...);
+			--d_start;
+			++d_size;
+			return front();
+		}
+		/// @brief Insert an element at the back of the container.
+		SEQ_ALWAYS_INLINE void push_back(const T& value) { emplace_back(value); }
+		/// @brief Insert an element at the back of the container using move semantic.
+		SEQ_ALWAYS_INLINE void push_back(T&& value) { emplace_back(std::move(value)); }
+		/// @brief Insert an element at the front of the container.
+		SEQ_ALWAYS_INLINE void push_front(const T& value) { emplace_front(value); }
+		/// @brief Insert an element at the front of the container using move semantic.
+		SEQ_ALWAYS_INLINE void push_front(T&& value) { emplace_front(std::move(value)); }
+
+		/// @brief Removes the last element of the container
+		SEQ_ALWAYS_INLINE void pop_back() noexcept
+		{
+			SEQ_ASSERT_DEBUG(size() > 0, "pop_back() on empty small_devector");
+			destroy_ptr(end() - 1);
+			--d_size;
+		}
+		/// @brief Removes the first element of the container
+		SEQ_ALWAYS_INLINE void pop_front() noexcept
+		{
+			SEQ_ASSERT_DEBUG(size() > 0, "pop_front() on empty small_devector");
+			destroy_ptr(begin());
+			++d_start;
+			--d_size;
+		}
+
+		/// @brief Inserts a new element into the container directly before pos.
+		/// The values are pushed to either ends, whichever is faster.
+		/// @return iterator to the inserted element
+		template<class... Args>
+		auto emplace(const_iterator pos, Args&&... args) -> iterator
+		{
+			size_t dist = static_cast<size_t>(pos - begin());
+			SEQ_ASSERT_DEBUG(dist <= size(), "small_devector: invalid insertion location");
+
+			if (dist < size() / 2) {
+				T tmp(std::forward<Args>(args)...); // handle aliasing
+				emplace_front(std::move(tmp));
+				std::rotate(begin(), begin() + 1, begin() + dist + 1);
+			}
+			else {
+				emplace_back(std::forward<Args>(args)...);
+				std::rotate(begin() + dist, end() - 1, end());
+			}
+			return begin() + dist;
+		}
+		/// @brief Inserts a new element into the container directly before pos.
+		auto insert(const_iterator pos, const T& value) -> iterator { return emplace(pos, value); }
+		/// @brief Inserts a new element into the container directly before pos using move semantic.
+		auto insert(const_iterator pos, T&& value) -> iterator { return emplace(pos, std::move(value)); }
+
+		/// @brief Removes the elements in the range [first, last).
+		/// @return Iterator following the last removed element
+		auto erase(const_iterator first, const_iterator last) -> iterator
+		{
+			SEQ_ASSERT_DEBUG(last >= first && first >= begin() && last <= end(), "small_devector erase iterator outside range");
+			size_t off = static_cast<size_t>(first - begin());
+			size_t count = static_cast<size_t>(last - first);
+			if (count == 0)
+				return begin() + off;
+
+			if (off < static_cast<size_t>(end() - last)) {
+				// closer to front
+				std::move_backward(begin(), begin() + off, begin() + off + count);
+				for (; count > 0; --count)
+					pop_front();
+			}
+			else {
+				std::move(begin() + off + count, end(), begin() + off);
+				for (; count > 0; --count)
+					pop_back();
+			}
+			return begin() + off;
+		}
+		/// @brief Removes the element at pos
+		auto erase(const_iterator pos) -> iterator { return erase(pos, pos + 1); }
+
+		/// @brief Assign elements from range [first, last) to the container.
+		template<class InputIt>
+		void assign(InputIt first, InputIt last)
+		{
+			clear();
+			if constexpr (is_random_access_v<InputIt>)
+				reserve(static_cast<size_t>(last - first));
+			for (; first != last; ++first)
+				emplace_back(*first);
+		}
+		/// @brief Replaces the contents with count copies of value value
+		void assign(size_type count, const T& value) { assign(cvalue_iterator<T>(0, value), cvalue_iterator<T>(count)); }
+
+		/// @brief Resizes the container to contain count elements.
+		template<class... U>
+		void resize(size_t count, const U&... value)
+		{
+			static_assert(sizeof...(U) < 2, "");
+			if (count <= d_size) {
+				while (d_size > count)
+					pop_back();
+				return;
+			}
+			reserve_back(count - d_size);
+			while (d_size < count)
+				emplace_back(value...);
+		}
+		/// @brief Resizes the container to contain count elements.
+		/// The container is extended or shrunk by the front.
+		template<class... U>
+		void resize_front(size_t count, const U&... value)
+		{
+			static_assert(sizeof...(U) < 2, "");
+			if (count <= d_size) {
+				while (d_size > count)
+					pop_front();
+				return;
+			}
+			reserve_front(count - d_size);
+			while (d_size < count)
+				emplace_front(value...);
+		}
+
+		/// @brief Returns pointer to the underlying array serving as element storage.
+		SEQ_ALWAYS_INLINE auto data() noexcept -> T* { return storage() + d_start; }
+		/// @brief Returns pointer to the underlying array serving as element storage.
+		SEQ_ALWAYS_INLINE auto data() const noexcept -> const T* { return storage() + d_start; }
+
+		/// @brief Returns a reference to the back element
+		SEQ_ALWAYS_INLINE auto back() noexcept -> T& { return *(end() - 1); }
+		/// @brief Returns a reference to the back element
+		SEQ_ALWAYS_INLINE auto back() const noexcept -> const T& { return *(end() - 1); }
+		/// @brief Returns a reference to the front element
+		SEQ_ALWAYS_INLINE auto front() noexcept -> T& { return *begin(); }
+		/// @brief Returns a reference to the front element
+		SEQ_ALWAYS_INLINE auto front() const noexcept -> const T& { return *begin(); }
+		/// @brief Returns a reference to the element at pos
+		SEQ_ALWAYS_INLINE auto operator[](size_t pos) noexcept -> T&
+		{
+			SEQ_ASSERT_DEBUG(pos < size(), "invalid position");
+			return data()[pos];
+		}
+		/// @brief Returns a reference to the element at pos
+		SEQ_ALWAYS_INLINE auto operator[](size_t pos) const noexcept -> const T&
+		{
+			SEQ_ASSERT_DEBUG(pos < size(), "invalid position");
+			return data()[pos];
+		}
+		/// @brief Returns a reference to the element at pos.
+		/// Throw std::out_of_range if pos is invalid.
+		auto at(size_t pos) -> T&
+		{
+			if (pos >= size())
+				throw std::out_of_range("small_devector out of range");
+			return data()[pos];
+		}
+		/// @brief Returns a reference to the element at pos.
+		/// Throw std::out_of_range if pos is invalid.
+		auto at(size_t pos) const -> const T&
+		{
+			if (pos >= size())
+				throw std::out_of_range("small_devector out of range");
+			return data()[pos];
+		}
+
+		SEQ_ALWAYS_INLINE auto begin() noexcept -> iterator { return data(); }
+		SEQ_ALWAYS_INLINE auto begin() const noexcept -> const_iterator { return data(); }
+		SEQ_ALWAYS_INLINE auto end() noexcept -> iterator { return data() + d_size; }
+		SEQ_ALWAYS_INLINE auto end() const noexcept -> const_iterator { return data() + d_size; }
+		SEQ_ALWAYS_INLINE auto cbegin() const noexcept -> const_iterator { return begin(); }
+		SEQ_ALWAYS_INLINE auto cend() const noexcept -> const_iterator { return end(); }
+		SEQ_ALWAYS_INLINE auto rbegin() noexcept -> reverse_iterator { return reverse_iterator(end()); }
+		SEQ_ALWAYS_INLINE auto rbegin() const noexcept -> const_reverse_iterator { return const_reverse_iterator(end()); }
+		SEQ_ALWAYS_INLINE auto rend() noexcept -> reverse_iterator { return reverse_iterator(begin()); }
+		SEQ_ALWAYS_INLINE auto rend() const noexcept -> const_reverse_iterator { return const_reverse_iterator(begin()); }
+		SEQ_ALWAYS_INLINE auto crbegin() const noexcept -> const_reverse_iterator { return rbegin(); }
+		SEQ_ALWAYS_INLINE auto crend() const noexcept -> const_reverse_iterator { return rend(); }
+	};
+
+	/// @brief Specialization of is_relocatable for small_devector: relocatable if T is relocatable
+	template<class T, size_t N, class Alloc>
+	struct is_relocatable<small_devector<T, N, Alloc>> : is_relocatable<T>
+	{
+	};
+
 }
 #endif
@@ -58,6 +58,12 @@ See the documentation of each class for more details.
 
 namespace seq
 {
+	// Buckets storing plain arithmetic back values can be compared with SIMD instructions
+	template<class T, class ValueCompare, class Key>
+	struct simd_key_access<detail::StoreBucket<T, ValueCompare, true, true>, Key> : std::is_same<typename ValueCompare::key_type, Key>
+	{
+	};
+
 	/// @brief Equivalent to C++23 std::sorted_unique_t
 	struct sorted_unique_t
 	{
@@ -112,11 +118,22 @@ namespace seq
 			using comparable = int;
 		};
 
+		template<class Key, class Less, bool IsNatural = (std::is_arithmetic_v<Key> && is_std_less<Less>::value)>
+		struct BaseNaturalLess
+		{
+		};
+		template<class Key, class Less>
+		struct BaseNaturalLess<Key, Less, true>
+		{
+			using natural_less = int;
+		};
+
 		// Comparison function used in flat_set/map
 		template<class Key, class Less, class Extract>
 		struct LessAdapter
 		  : public Less
-		  , public BaseComparable<Key, Less> // inherit the comparable typedef
+		  , public BaseComparable<Key, Less>  // inherit the comparable typedef
+		  , public BaseNaturalLess<Key, Less> // inherit the natural_less typedef (SIMD lower bound)
 		{
 			LessAdapter() {}
 			LessAdapter(const Less& l)
@@ -218,6 +235,31 @@ namespace seq
 			}
 		}
 
+		/// @brief Lower bound within a single bucket (circular buffer) of a sorted tiered_vector.
+		/// Returns the position of the lower bound relative to the bucket front.
+		template<bool Multi, class KeyType, class Bucket, class U, class Less>
+		SEQ_INLINE_BINARY_SEARCH auto bucket_lower_bound(const Bucket* bucket, const U& value, const Less& le) noexcept(noexcept(le(*bucket->buffer(), value)))
+		  -> std::pair<int, bool>
+		{
+			// Partition the bucket into left/right side based on the circular buffer begin position,
+			// and apply the lower bound on one of the 2.
+
+			using pos_type = int;
+			const auto* begin_ptr = bucket->begin_ptr();
+
+			const bool low_half = begin_ptr != bucket->buffer() &&			    // begin is not 0
+					      (bucket->begin + bucket->size) > bucket->max_size_ && // begin + size overflow
+					      le(*(bucket->buffer() + bucket->max_size1), value);   // value to took for is not in the upper half (between begin and buffer end)
+
+			const auto* ptr = low_half ? bucket->buffer() : begin_ptr;
+			const pos_type partition_size =
+			  low_half ? ((bucket->begin + bucket->size) & bucket->max_size1) : (std::min(bucket->size, static_cast<detail::cbuffer_pos>(bucket->max_size_ - bucket->begin)));
+
+			auto _low = lower_bound<Multi, KeyType>(ptr, partition_size, value, le);
+			_low.first = ptr == begin_ptr ? _low.first : _low.first + (bucket->max_size_ - bucket->begin);
+			return _low;
+		}
+
 		/// @brief Optimized version of std::lower_bound(begin(),end(),value,le);
 		/// Only works for sorted tiered_vector.
 		template<bool Multi, class Deque, class U, class Less>
@@ -227,7 +269,6 @@ namespace seq
 			if SEQ_UNLIKELY (!d.manager())
 				return { 0, false };
 
-			using T = typename Deque::value_type;
 			using bucket_manager = typename Deque::bucket_manager;
 			using BucketVector = typename bucket_manager::BucketVector;
 			// using BucketType = typename BucketVector::value_type;
@@ -275,24 +316,7 @@ namespace seq
 
 			// find inside bucket
 			const auto* bucket = buckets[b_index].bucket;
-
-			// Partition the bucket into left/right side based on the circular buffer begin position,
-			// and apply the lower bound on one of the 2.
-
-			using pos_type = int;
-			const T* begin_ptr = bucket->begin_ptr();
-
-			const bool low_half = begin_ptr != bucket->buffer() &&			    // begin is not 0
-					      (bucket->begin + bucket->size) > bucket->max_size_ && // begin + size overflow
-					      le(*(bucket->buffer() + bucket->max_size1), value);   // value to took for is not in the upper half (between begin and buffer end)
-
-			const T* ptr = low_half ? bucket->buffer() : begin_ptr;
-			const pos_type partition_size =
-			  low_half ? ((bucket->begin + bucket->size) & bucket->max_size1) : (std::min(bucket->size, static_cast<detail::cbuffer_pos>(bucket->max_size_ - bucket->begin)));
-
-			auto _low = lower_bound<Multi, KeyType>(ptr, partition_size, value, le);
-
-			_low.first = ptr == begin_ptr ? _low.first : _low.first + (bucket->max_size_ - bucket->begin);
+			auto _low = bucket_lower_bound<Multi, KeyType>(bucket, value, le);
 			size_t r =
 			  static_cast<size_t>(_low.first) + (b_index != 0 ? static_cast<size_t>(buckets[0]->size) + static_cast<size_t>(b_index - 1) * static_cast<size_t>(bucket->max_size_) : 0);
 			return { r, _low.second };
@@ -326,6 +350,90 @@ namespace seq
 			}
 		}
 
+		/// @brief Position of the last lower bound found by tvector_lower_bound_from()
+		struct TVectorCursor
+		{
+			size_t bucket = 0;
+			cbuffer_pos pos = 0;
+		};
+
+		/// @brief Equivalent to tvector_lower_bound(), but starts the search from a previous hit.
+		/// Only works for sorted tiered_vector, and if value is not less than the previously searched value.
+		///
+		/// Buckets are skipped using an exponential (galloping) search on their back values,
+		/// followed by a binary search on the last bucket range. Inside the bucket, the search
+		/// gallops from the previous position if the bucket is the same or the next one.
+		/// This makes the lookup of dense sorted probes almost linear in the number of probes.
+		template<bool Multi, class Deque, class U, class Less>
+		SEQ_INLINE_BINARY_SEARCH auto tvector_lower_bound_from(const Deque& d, const U& value, const Less& le, TVectorCursor& cursor) noexcept(
+		  noexcept(le(std::declval<typename Deque::value_type&>(), value))) -> size_t
+		{
+			if SEQ_UNLIKELY (!d.manager())
+				return 0;
+
+			using bucket_manager = typename Deque::bucket_manager;
+			using BucketVector = typename bucket_manager::BucketVector;
+			using ValueCompare = typename Deque::value_compare;
+			using KeyType = typename ValueCompare::key_type;
+			const BucketVector& buckets = d.manager()->buckets();
+			const size_t bcount = buckets.size();
+
+			size_t b_index = cursor.bucket;
+			if SEQ_UNLIKELY (b_index >= bcount)
+				return d.size();
+
+			if (le(buckets[b_index], value)) {
+				// Gallop over the next buckets
+				size_t low = b_index + 1;
+				size_t high = low;
+				size_t step = 1;
+				while (high < bcount && le(buckets[high], value)) {
+					low = high + 1;
+					high = low + step;
+					step <<= 1U;
+				}
+				high = std::min(high + 1, bcount);
+				b_index = low + lower_bound<Multi, KeyType>(buckets.data() + low, high - low, value, le).first;
+				if (b_index == bcount) {
+					cursor.bucket = bcount;
+					return d.size();
+				}
+				if (b_index != cursor.bucket + 1) {
+					// Far jump: use the standard bucket lower bound
+					const auto* bucket = buckets[b_index].bucket;
+					cursor.bucket = b_index;
+					cursor.pos = bucket_lower_bound<Multi, KeyType>(bucket, value, le).first;
+					return static_cast<size_t>(cursor.pos) +
+					       (b_index != 0 ? static_cast<size_t>(buckets[0]->size) + static_cast<size_t>(b_index - 1) * static_cast<size_t>(bucket->max_size_) : 0);
+				}
+				cursor.pos = 0;
+			}
+
+			// Gallop inside the bucket from the previous position
+			const auto* bucket = buckets[b_index].bucket;
+			cbuffer_pos low = cursor.pos;
+			cbuffer_pos high = low;
+			cbuffer_pos step = 1;
+			const cbuffer_pos size = bucket->size;
+			while (high < size && le((*bucket)[high], value)) {
+				low = high + 1;
+				high = low + step;
+				step <<= 1;
+			}
+			high = std::min(high + 1, size);
+			while (low < high) {
+				const cbuffer_pos mid = (low + high) >> 1;
+				if (le((*bucket)[mid], value))
+					low = mid + 1;
+				else
+					high = mid;
+			}
+			cursor.bucket = b_index;
+			cursor.pos = low;
+			return static_cast<size_t>(low) +
+			       (b_index != 0 ? static_cast<size_t>(buckets[0]->size) + static_cast<size_t>(b_index - 1) * static_cast<size_t>(bucket->max_size_) : 0);
+		}
+
 		/**
 		 * \internal
 		 * Merge 2 sorted ranges into a single array (or tiered_vector).
@@ -405,6 +513,106 @@ namespace seq
 			}
 		}
 
+		/// @brief Exponential (galloping) version of std::lower_bound starting from first.
+		/// Cheap when the result is close to first, O(log(distance)) otherwise.
+		template<class Iter, class U, class Less>
+		SEQ_ALWAYS_INLINE Iter gallop_lower_bound(Iter first, Iter last, const U& value, const Less& le)
+		{
+			if (first == last || !le(*first, value))
+				return first;
+			// *first < value
+			using diff_type = typename std::iterator_traits<Iter>::difference_type;
+			const diff_type size = last - first;
+			diff_type low = 1;
+			diff_type step = 1;
+			while (low < size && le(*(first + low), value)) {
+				step <<= 1;
+				low += step;
+			}
+			const diff_type high = std::min(low + 1, size);
+			low = std::max(low - step + 1, static_cast<diff_type>(1));
+			return std::lower_bound(first + low, first + high, value, le);
+		}
+
+		/// @brief Union of 2 sorted ranges, written to out. Equal values are taken from the first range.
+		/// Galloping is used to copy whole runs of consecutive values from the same range.
+		/// If Unique2 is true, the first range is unique and equivalent values of the second range are
+		/// collapsed, so that the output is unique (union of a unique container with a multi container).
+		template<bool Unique2 = false, class Iter1, class Iter2, class Out, class Less>
+		Out gallop_set_union(Iter1 first1, Iter1 last1, Iter2 first2, Iter2 last2, Out out, const Less& le)
+		{
+			auto copy2 = [&le](Iter2 f, Iter2 l, Out o) {
+				if constexpr (Unique2)
+					return std::unique_copy(f, l, o, [&le](const auto& a, const auto& b) { return !le(a, b); });
+				else
+					return std::copy(f, l, o);
+			};
+			while (first1 != last1 && first2 != last2) {
+				if (le(*first1, *first2)) {
+					Iter1 it = gallop_lower_bound(first1, last1, *first2, le);
+					out = std::copy(first1, it, out);
+					first1 = it;
+				}
+				else if (le(*first2, *first1)) {
+					Iter2 it = gallop_lower_bound(first2, last2, *first1, le);
+					out = copy2(first2, it, out);
+					first2 = it;
+				}
+				else {
+					*out = *first1;
+					++out;
+					++first2;
+					if constexpr (Unique2) {
+						// skip all equivalent values of the second range
+						while (first2 != last2 && !le(*first1, *first2))
+							++first2;
+					}
+					++first1;
+				}
+			}
+			out = std::copy(first1, last1, out);
+			return copy2(first2, last2, out);
+		}
+
+		/// @brief Call fun(a, b) for each pair of equivalent values from 2 sorted ranges.
+		/// Galloping is used to skip values without match, which makes this function
+		/// O(min(N1, N2) * log(max(N1, N2) / min(N1, N2))) for skewed inputs.
+		template<class Iter1, class Iter2, class Less, class Fun>
+		void gallop_set_join(Iter1 first1, Iter1 last1, Iter2 first2, Iter2 last2, const Less& le, Fun&& fun)
+		{
+			while (first1 != last1 && first2 != last2) {
+				if (le(*first1, *first2))
+					first1 = gallop_lower_bound(first1, last1, *first2, le);
+				else if (le(*first2, *first1))
+					first2 = gallop_lower_bound(first2, last2, *first1, le);
+				else {
+					fun(*first1, *first2);
+					++first1;
+					++first2;
+				}
+			}
+		}
+
+		/// @brief Values of the first sorted range not present in the second one, written to out.
+		template<class Iter1, class Iter2, class Out, class Less>
+		Out gallop_set_difference(Iter1 first1, Iter1 last1, Iter2 first2, Iter2 last2, Out out, const Less& le)
+		{
+			while (first1 != last1 && first2 != last2) {
+				if (le(*first1, *first2)) {
+					Iter1 it = gallop_lower_bound(first1, last1, *first2, le);
+					out = std::copy(first1, it, out);
+					first1 = it;
+				}
+				else if (le(*first2, *first1))
+					first2 = gallop_lower_bound(first2, last2, *first1, le);
+				else {
+					++first1;
+					++first2;
+				}
+			}
+			return std::copy(first1, last1, out);
+		}
+
 		/// @brief Base class for flat_map/set
 		/// Uses a seq::tiered_vector to store the values and provide faster insertion/deletion of unique elements.
 		template<class Key, class Value = Key, class Compare = std::less<>, class Allocator = std::allocator<Value>, bool Stable = true, bool Unique = true>
@@ -416,6 +624,7 @@ namespace seq
 			using this_type = flat_tree<Key, Value, Compare, Allocator, Stable, Unique>;
 
 			static constexpr bool Comparable = has_comparable<base_type>::value;
+			static constexpr bool UniqueKeys = Unique;
 
 			SEQ_ALWAYS_INLINE auto base() noexcept -> base_type& { return (*this); }
 			SEQ_ALWAYS_INLINE auto base() const noexcept -> const base_type& { return (*this); }
@@ -477,7 +686,7 @@ namespace seq
 					++count;
 				}
 				while (first != last) {
-					push_back(*first);
+					d_deque.push_back(*first);
 					if (sorted) {
 						if ((*this)(*first, *prev))
 							sorted = false;
@@ -491,7 +700,7 @@ namespace seq
 				}
 
 				// Resize if the tiered_vector was bigger
-				resize(count);
+				d_deque.resize(count);
 
 				// Sort if necessary, remove non unique values if necessary
 				if (!sorted)
@@ -914,6 +1123,103 @@ namespace seq
 				return std::pair<size_t, size_t>(low, up);
 			}
 
+			/// @brief Batch lookup of the keys in [first, last).
+			/// Calls fun(index, pos) for each key, where index is the key position in the input range
+			/// and pos its position in the container (or size() if not found).
+			/// Keys are looked up in sorted order using a monotonic walk of the tiered_vector buckets.
+			/// If the input range is not sorted, the keys are first sorted using net_sort().
+			template<class Iter, class Fun>
+			void find_batch(Iter first, Iter last, Fun&& fun) const
+			{
+				using K = typename std::iterator_traits<Iter>::value_type;
+				if (first == last)
+					return;
+
+				TVectorCursor cursor;
+				auto find_from = [&](const K& key) {
+					size_t pos = tvector_lower_bound_from<!Unique>(d_deque, key, base(), cursor);
+					if (pos != d_deque.size() && (*this)(key, d_deque[pos]))
+						pos = d_deque.size();
+					return pos;
+				};
+
+				if (std::is_sorted(first, last, base())) {
+					for (size_t i = 0; first != last; ++first, ++i)
+						fun(i, find_from(*first));
+					return;
+				}
+
+				// Sort keys addresses, keep the input index
+				std::vector<std::pair<const K*, size_t>> keys;
+				if constexpr (is_random_access_v<Iter>)
+					keys.reserve(static_cast<size_t>(last - first));
+				for (size_t i = 0; first != last; ++first, ++i)
+					keys.emplace_back(std::addressof(*first), i);
+				net_sort(keys.begin(), keys.end(), [this](const auto& l, const auto& r) { return (*this)(*l.first, *r.first); });
+				for (const auto& k : keys)
+					fun(k.second, find_from(*k.first));
+			}
+
+			// Output iterator appending values to a tiered_vector bucket manager
+			struct sorted_appender
+			{
+				using iterator_category = std::output_iterator_tag;
+				using value_type = void;
+				using difference_type = std::ptrdiff_t;
+				using pointer = void;
+				using reference = void;
+
+				typename container_type::bucket_manager* manager;
+				template<class U>
+				SEQ_ALWAYS_INLINE sorted_appender& operator=(U&& value)
+				{
+					manager->emplace_back(std::forward<U>(value));
+					return *this;
+				}
+				SEQ_ALWAYS_INLINE sorted_appender& operator*() noexcept { return *this; }
+				SEQ_ALWAYS_INLINE sorted_appender& operator++() noexcept { return *this; }
+				SEQ_ALWAYS_INLINE sorted_appender& operator++(int) noexcept { return *this; }
+			};
+
+			/// @brief Build a sorted container of at most max_size values using fun(out_iterator).
+			/// The bucket size is selected once for max_size, and values are appended directly to the bucket manager
+			/// (which keeps bucket back values up to date). Values are never default constructed.
+			template<class Fun>
+			auto build_sorted(size_t max_size, Fun&& fun) const -> container_type
+			{
+				container_type out(d_deque.get_allocator());
+				out.reserve(max_size);
+				fun(sorted_appender{ out.manager() });
+				return out;
+			}
+			template<class Tree>
+			auto set_union(const Tree& other) const -> container_type
+			{
+				// A unique container merged with a multi container must collapse the duplicates of the latter
+				return build_sorted(size() + other.size(), [&](auto out) { return gallop_set_union<UniqueKeys && !Tree::UniqueKeys>(begin(), end(), other.begin(), other.end(), out, base()); });
+			}
+			template<class Tree>
+			auto set_intersection(const Tree& other) const -> container_type
+			{
+				return build_sorted(std::min(size(), other.size()), [&](auto out) {
+					gallop_set_join(begin(), end(), other.begin(), other.end(), base(), [&out](const auto& v, const auto&) {
+						*out = v;
+						++out;
+					});
+					return out;
+				});
+			}
+			template<class Tree>
+			auto set_difference(const Tree& other) const -> container_type
+			{
+				return build_sorted(size(), [&](auto out) { return gallop_set_difference(begin(), end(), other.begin(), other.end(), out, base()); });
+			}
+			template<class Tree, class Fun>
+			void join(const Tree& other, Fun&& fun) const
+			{
+				gallop_set_join(begin(), end(), other.begin(), other.end(), base(), std::forward<Fun>(fun));
+			}
+
 			template<class C2, bool Unique2>
 			void merge(flat_tree<Key, Key, C2, Allocator, Unique2>& source)
 			{
@@ -1065,6 +1371,9 @@ namespace seq
 		using flat_tree_type = detail::flat_tree<Key, Key, Compare, Allocator, Stable, Unique>;
 		flat_tree_type d_tree;
 
+		template<class K2, class C2, class A2, bool S2, bool U2>
+		friend class flat_set;
+
 		using Policy = detail::BuildValue<Key, has_is_transparent<Compare>::value>;
 
 	public:
@@ -1496,6 +1805,86 @@ namespace seq
 		/// Alternatively, the first iterator may be obtained with lower_bound_pos(), and the second with upper_bound_pos().
 		SEQ_ALWAYS_INLINE auto equal_range_pos(const Key& key) const -> std::pair<size_t, size_t> { return d_tree.equal_range_pos(key); }
 
+		/// @brief Batch version of find_pos().
+		/// Writes to out[i] the position of the i-th key of the range [first, last), or size() if this key is not found.
+		/// Keys are searched in sorted order by walking the underlying tiered_vector buckets monotonically using a galloping search,
+		/// which is much faster than calling find_pos() for each key when the probes are dense.
+		/// If the range [first, last) is not sorted, the keys are first sorted internally.
+		/// @param first beginning of the range of keys to look for
+		/// @param last end of the range of keys to look for
+		/// @param out random access iterator to the output positions
+		/// @return number of found keys
+		template<class Iter, class Out>
+		auto find_batch_pos(Iter first, Iter last, Out out) const -> size_type
+		{
+			size_type found = 0;
+			d_tree.find_batch(first, last, [&](size_t i, size_t p) {
+				out[i] = p;
+				found += (p != size());
+			});
+			return found;
+		}
+		/// @brief Batch version of find().
+		/// Writes to out[i] an iterator to the i-th key of the range [first, last), or end() if this key is not found.
+		/// See find_batch_pos() for more details.
+		/// @return number of found keys
+		template<class Iter, class Out>
+		auto find_batch(Iter first, Iter last, Out out) const -> size_type
+		{
+			size_type found = 0;
+			d_tree.find_batch(first, last, [&](size_t i, size_t p) {
+				out[i] = d_tree.iterator_at(p);
+				found += (p != size());
+			});
+			return found;
+		}
+		/// @brief Batch version of contains().
+		/// Writes to out[i] true if the i-th key of the range [first, last) is in the container, false otherwise.
+		/// See find_batch_pos() for more details.
+		/// @return number of found keys
+		template<class Iter, class Out>
+		auto contains_batch(Iter first, Iter last, Out out) const -> size_type
+		{
+			size_type found = 0;
+			d_tree.find_batch(first, last, [&](size_t i, size_t p) {
+				out[i] = (p != size());
+				found += (p != size());
+			});
+			return found;
+		}
+
+		/// @brief Returns the union of this container and other, similar to std::set_union.
+		/// If a value is present in both containers, the one from this container is kept.
+		/// If this container is unique and other is a multiset, equivalent values of other are inserted only once.
+		/// The result is appended directly to a tiered_vector, and galloping is used to copy whole runs
+		/// of consecutive values from the same container, which is very efficient for skewed sizes.
+		/// other must be sorted according to this container's comparison function.
+		template<class A2, bool S2, bool U2>
+		auto merge_union(const flat_set<Key, Compare, A2, S2, U2>& other) const -> flat_set
+		{
+			flat_set res(key_comp(), get_allocator());
+			res.d_tree.d_deque = d_tree.set_union(other.d_tree);
+			return res;
+		}
+		/// @brief Returns the intersection of this container and other, similar to std::set_intersection.
+		/// Values are taken from this container. Galloping is used to skip values without match,
+		/// so that the cost is roughly O(min(N1, N2) * log(max(N1, N2) / min(N1, N2))) for skewed sizes.
+		template<class A2, bool S2, bool U2>
+		auto merge_intersection(const flat_set<Key, Compare, A2, S2, U2>& other) const -> flat_set
+		{
+			flat_set res(key_comp(), get_allocator());
+			res.d_tree.d_deque = d_tree.set_intersection(other.d_tree);
+			return res;
+		}
+		/// @brief Returns the values of this container not present in other, similar to std::set_difference.
+		template<class A2, bool S2, bool U2>
+		auto merge_difference(const flat_set<Key, Compare, A2, S2, U2>& other) const -> flat_set
+		{
+			flat_set res(key_comp(), get_allocator());
+			res.d_tree.d_deque = d_tree.set_difference(other.d_tree);
+			return res;
+		}
+
 		/// @brief Attempts to extract each element in source and insert it into this using the comparison object of this.
 		/// If there is an element in this with key equivalent to the key of an element from source, then that element is not extracted from source.
 		/// Note that elements from source are moved to this.
@@ -1691,6 +2080,9 @@ namespace seq
 		using flat_tree_type = detail::flat_tree<Key, std::pair<Key, T>, Compare, Allocator, Stable, Unique>;
 		flat_tree_type d_tree;
 
+		template<class K2, class T2, class C2, class A2, bool S2, bool U2>
+		friend class flat_map;
+
 		using Policy = detail::BuildValue<std::pair<Key, T>, has_is_transparent<Compare>::value>;
 
 	public:
@@ -2071,6 +2463,86 @@ namespace seq
 		}
 		SEQ_ALWAYS_INLINE auto equal_range_pos(const Key& x) const -> std::pair<size_t, size_t> { return d_tree.equal_range_pos(x); }
 
+		/// @brief Batch version of find_pos(), see flat_set::find_batch_pos() for more details.
+		template<class Iter, class Out>
+		auto find_batch_pos(Iter first, Iter last, Out out) const -> size_type
+		{
+			size_type found = 0;
+			d_tree.find_batch(first, last, [&](size_t i, size_t p) {
+				out[i] = p;
+				found += (p != size());
+			});
+			return found;
+		}
+		/// @brief Batch version of find(), see flat_set::find_batch() for more details.
+		template<class Iter, class Out>
+		auto find_batch(Iter first, Iter last, Out out) -> size_type
+		{
+			size_type found = 0;
+			d_tree.find_batch(first, last, [&](size_t i, size_t p) {
+				out[i] = d_tree.iterator_at(p);
+				found += (p != size());
+			});
+			return found;
+		}
+		/// @brief Batch version of find(), see flat_set::find_batch() for more details.
+		template<class Iter, class Out>
+		auto find_batch(Iter first, Iter last, Out out) const -> size_type
+		{
+			size_type found = 0;
+			d_tree.find_batch(first, last, [&](size_t i, size_t p) {
+				out[i] = d_tree.iterator_at(p);
+				found += (p != size());
+			});
+			return found;
+		}
+		/// @brief Batch version of contains(), see flat_set::contains_batch() for more details.
+		template<class Iter, class Out>
+		auto contains_batch(Iter first, Iter last, Out out) const -> size_type
+		{
+			size_type found = 0;
+			d_tree.find_batch(first, last, [&](size_t i, size_t p) {
+				out[i] = (p != size());
+				found += (p != size());
+			});
+			return found;
+		}
+
+		/// @brief Returns the union of this container and other, see flat_set::merge_union().
+		template<class A2, bool S2, bool U2>
+		auto merge_union(const flat_map<Key, T, Compare, A2, S2, U2>& other) const -> flat_map
+		{
+			flat_map res(key_comp(), get_allocator());
+			res.d_tree.d_deque = d_tree.set_union(other.d_tree);
+			return res;
+		}
+		/// @brief Returns the intersection of this container and other, see flat_set::merge_intersection().
+		template<class A2, bool S2, bool U2>
+		auto merge_intersection(const flat_map<Key, T, Compare, A2, S2, U2>& other) const -> flat_map
+		{
+			flat_map res(key_comp(), get_allocator());
+			res.d_tree.d_deque = d_tree.set_intersection(other.d_tree);
+			return res;
+		}
+		/// @brief Returns the values of this container whose key is not present in other, see flat_set::merge_difference().
+		template<class A2, bool S2, bool U2>
+		auto merge_difference(const flat_map<Key, T, Compare, A2, S2, U2>& other) const -> flat_map
+		{
+			flat_map res(key_comp(), get_allocator());
+			res.d_tree.d_deque = d_tree.set_difference(other.d_tree);
+			return res;
+		}
+		/// @brief Merge-join this container with another sorted map.
+		/// Calls fun(a, b) for each pair of values a (from this) and b (from other) having equivalent keys.
+		/// Both containers are walked in sorted order, and galloping is used to skip keys without match,
+		/// which makes joining a large map with a small one roughly O(N_small * log(N_large / N_small)).
+		/// For multimaps, equivalent keys are matched in order (like std::set_intersection).
+		template<class T2, class A2, bool S2, bool U2, class Fun>
+		void join(const flat_map<Key, T2, Compare, A2, S2, U2>& other, Fun&& fun) const
+		{
+			d_tree.join(other.d_tree, std::forward<Fun>(fun));
+		}
+
 		template<class C2>
 		SEQ_ALWAYS_INLINE void merge(flat_map<Key, T, C2, Allocator>& source)
 		{
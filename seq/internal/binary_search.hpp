@@ -27,10 +27,33 @@
 #define SEQ_BINARY_SEARCH_HPP
 
 #include "../type_traits.hpp"
+#include "simd.hpp"
 #include <algorithm>
 
 namespace seq
 {
+	/// @brief Tells if keys of type Key can be read directly inside objects of type T
+	/// (at offset 0) for SIMD comparisons. Specialized for tiered_vector buckets storing plain back values.
+	template<class T, class Key>
+	struct simd_key_access : std::is_same<T, Key>
+	{
+	};
+
+#ifdef SEQ_NO_SIMD_LOWER_BOUND
+	static constexpr bool simd_lower_bound_disabled = true;
+#else
+	static constexpr bool simd_lower_bound_disabled = false;
+#endif
+
+	/// @brief Tells if the comparison function is a plain operator< on arithmetic keys
+	template<class T, class = void>
+	struct has_natural_less : std::false_type
+	{
+	};
+	template<class T>
+	struct has_natural_less<T, std::void_t<typename T::natural_less>> : std::true_type
+	{
+	};
 
 
 	template<bool Multi, class Key, class Iter, class SizeType, class U, class Less>
@@ -51,7 +74,13 @@ namespace seq
 				size = half;
 
 			}
-			// Finish with linear probing
+			// Finish with linear probing.
+			// The vectorized probe can be disabled by defining SEQ_NO_SIMD_LOWER_BOUND.
+			if constexpr (!simd_lower_bound_disabled && has_natural_less<Less>::value && std::is_same_v<U, Key> && std::is_pointer_v<Iter> && simd_key_access<T, Key>::value &&
+				      (sizeof(Key) == 4 || sizeof(Key) == 8)) {
+				// Vectorized count of the values less than value
+				return { low + static_cast<SizeType>(detail::simd_count_less<Key>(ptr + low, sizeof(T), static_cast<size_t>(size), value)), false };
+			}
 			size += low;
 			while (low < size && le(ptr[low], value))
 				++low;
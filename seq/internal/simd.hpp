@@ -346,6 +346,112 @@ namespace seq
 		}
 	}
 
+	namespace detail
+	{
+		// Number of bits set in a movemask result
+		SEQ_ALWAYS_INLINE unsigned simd_mask_count(unsigned mask) noexcept
+		{
+			return popcnt32(mask);
+		}
+
+		/// @brief Returns the number of keys less than value in the range of count keys starting at base,
+		/// where each key is separated from the next one by stride bytes.
+		/// For a sorted range, this is equivalent to the lower bound position of value.
+		///
+		/// Uses SSE2/SSE4.2/AVX2 comparisons for 32 and 64 bits arithmetic keys.
+		/// Contiguous keys (stride == sizeof(Key)) are loaded directly, strided keys
+		/// are gathered with AVX2. Other cases fall back to a scalar loop.
+		template<class Key>
+		SEQ_ALWAYS_INLINE size_t simd_count_less(const void* base, size_t stride, size_t count, Key value) noexcept
+		{
+			const char* p = static_cast<const char*>(base);
+			size_t res = 0;
+			size_t i = 0;
+			(void)stride;
+
+#if defined(__AVX2__)
+			if constexpr (sizeof(Key) == 4 && (std::is_integral_v<Key> || std::is_same_v<Key, float>)) {
+				const __m256i idx = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(stride)));
+				if constexpr (std::is_same_v<Key, float>) {
+					const __m256 v = _mm256_set1_ps(value);
+					for (; i + 8 <= count; i += 8) {
+						const char* ptr = p + i * stride;
+						__m256 k = stride == 4 ? _mm256_loadu_ps(reinterpret_cast<const float*>(ptr)) : _mm256_mask_i32gather_ps(_mm256_setzero_ps(), reinterpret_cast<const float*>(ptr), idx, _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 1);
+						res += simd_mask_count(static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(k, v, _CMP_LT_OQ))));
+					}
+				}
+				else {
+					// Signed comparison, flip the sign bit for unsigned keys
+					const __m256i bias = _mm256_set1_epi32(std::is_signed_v<Key> ? 0 : static_cast<int>(0x80000000U));
+					const __m256i v = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(value)), bias);
+					for (; i + 8 <= count; i += 8) {
+						const char* ptr = p + i * stride;
+						__m256i k = stride == 4 ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)) : _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), reinterpret_cast<const int*>(ptr), idx, _mm256_set1_epi32(-1), 1);
+						k = _mm256_xor_si256(k, bias);
+						res += simd_mask_count(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, k)))));
+					}
+				}
+			}
+			else if constexpr (sizeof(Key) == 8 && (std::is_integral_v<Key> || std::is_same_v<Key, double>)) {
+				const __m128i idx = _mm_mullo_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(static_cast<int>(stride)));
+				if constexpr (std::is_same_v<Key, double>) {
+					const __m256d v = _mm256_set1_pd(value);
+					for (; i + 4 <= count; i += 4) {
+						const char* ptr = p + i * stride;
+						__m256d k = stride == 8 ? _mm256_loadu_pd(reinterpret_cast<const double*>(ptr)) : _mm256_mask_i32gather_pd(_mm256_setzero_pd(), reinterpret_cast<const double*>(ptr), idx, _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 1);
+						res += simd_mask_count(static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(k, v, _CMP_LT_OQ))));
+					}
+				}
+				else {
+					const __m256i bias = _mm256_set1_epi64x(std::is_signed_v<Key> ? 0 : static_cast<long long>(0x8000000000000000ULL));
+					const __m256i v = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<long long>(value)), bias);
+					for (; i + 4 <= count; i += 4) {
+						const char* ptr = p + i * stride;
+						__m256i k = stride == 8 ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)) : _mm256_mask_i32gather_epi64(_mm256_setzero_si256(), reinterpret_cast<const long long*>(ptr), idx, _mm256_set1_epi64x(-1), 1);
+						k = _mm256_xor_si256(k, bias);
+						res += simd_mask_count(static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(v, k)))));
+					}
+				}
+			}
+#elif defined(__SSE2__)
+			if (stride == sizeof(Key)) {
+				if constexpr (std::is_same_v<Key, float>) {
+					const __m128 v = _mm_set1_ps(value);
+					for (; i + 4 <= count; i += 4)
+						res += simd_mask_count(static_cast<unsigned>(_mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(reinterpret_cast<const float*>(p) + i), v))));
+				}
+				else if constexpr (std::is_same_v<Key, double>) {
+					const __m128d v = _mm_set1_pd(value);
+					for (; i + 2 <= count; i += 2)
+						res += simd_mask_count(static_cast<unsigned>(_mm_movemask_pd(_mm_cmplt_pd(_mm_loadu_pd(reinterpret_cast<const double*>(p) + i), v))));
+				}
+				else if constexpr (sizeof(Key) == 4 && std::is_integral_v<Key>) {
+					const __m128i bias = _mm_set1_epi32(std::is_signed_v<Key> ? 0 : static_cast<int>(0x80000000U));
+					const __m128i v = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(value)), bias);
+					for (; i + 4 <= count; i += 4) {
+						__m128i k = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i * 4)), bias);
+						res += simd_mask_count(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(v, k)))));
+					}
+				}
+#if defined(__SSE4_2__)
+				else if constexpr (sizeof(Key) == 8 && std::is_integral_v<Key>) {
+					const __m128i bias = _mm_set1_epi64x(std::is_signed_v<Key> ? 0 : static_cast<long long>(0x8000000000000000ULL));
+					const __m128i v = _mm_xor_si128(_mm_set1_epi64x(static_cast<long long>(value)), bias);
+					for (; i + 2 <= count; i += 2) {
+						__m128i k = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i * 8)), bias);
+						res += simd_mask_count(static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(v, k)))));
+					}
+				}
+#endif
+			}
+#endif
+			// Scalar tail
+			for (; i < count; ++i)
+				res += *reinterpret_cast<const Key*>(p + i * stride) < value;
+			return res;
+		}
+	}
+
 	/// @brief Returns the plateform CPU features
 	SEQ_ALWAYS_INLINE const CPUFeatures& cpu_features()
 	{
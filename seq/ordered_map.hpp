@@ -28,10 +28,15 @@
 /** @file */
 
 #include "internal/hash_utils.hpp"
+#include "internal/simd.hpp"
 #include "sequence.hpp"
 #include "utils.hpp"
 #include "hash.hpp"
 
+#include <atomic>
+#include <execution>
+#include <mutex>
+
 namespace seq
 {
 	namespace detail
@@ -110,6 +115,50 @@ namespace seq
 				(reinterpret_cast<char*>(&val))[index_dist] = static_cast<char>(tombstone);
 			}
 			SEQ_ALWAYS_INLINE void set_distance(dist_type dist) noexcept { (reinterpret_cast<char*>(&val))[index_dist] = static_cast<char>(dist); }
+
+#if SEQ_BYTEORDER_ENDIAN == SEQ_BYTEORDER_LITTLE_ENDIAN && defined(__SSE2__) && !defined(SEQ_NO_SIMD_PROBE)
+#ifndef SEQ_SIMD_PROBE_START
+#define SEQ_SIMD_PROBE_START 4
+#endif
+#if defined(__AVX2__)
+			static constexpr unsigned group_size = 4;
+#else
+			static constexpr unsigned group_size = 2;
+#endif
+			// Probe distance from which group probing is used. Shorter probe chains (the vast majority below
+			// a load factor of 0.7) are faster to walk one node at a time.
+			static constexpr dist_type group_start = SEQ_SIMD_PROBE_START;
+			// Probe group_size consecutive nodes starting at p, the first one being at probe distance dist.
+			// Returns the index of the first node breaking the probe chain (distance lower than its probe distance), or group_size.
+			// Set match to the bit mask of nodes having the tiny hash h.
+			// Both the hash and distance bytes live in the upper 32 bits of each node, so 32 bits compares are enough,
+			// and _mm_movemask_pd() only keeps the upper result.
+			static SEQ_ALWAYS_INLINE auto probe_group(const RobinNode* p, tiny_hash h, dist_type dist, unsigned& match) noexcept -> unsigned
+			{
+				static_assert(index_dist == 6 && index_hash == 7, "invalid RobinNode layout");
+#if defined(__AVX2__)
+				const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+				const __m256i hashes = _mm256_and_si256(v, _mm256_set1_epi64x(static_cast<long long>(0xFF00000000000000ULL)));
+				const __m256i dists = _mm256_srai_epi32(_mm256_slli_epi64(v, 8), 24);
+				const __m256i probe = _mm256_add_epi32(_mm256_set1_epi64x(static_cast<long long>(static_cast<std::uint64_t>(dist) << 32U)),
+								       _mm256_setr_epi64x(0, 1LL << 32, 2LL << 32, 3LL << 32));
+				match = static_cast<unsigned>(
+				  _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi32(hashes, _mm256_set1_epi64x(static_cast<long long>(static_cast<std::uint64_t>(h) << 56U))))));
+				const unsigned stop = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi32(probe, dists))));
+#else
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+				const __m128i hashes = _mm_and_si128(v, _mm_set1_epi64x(static_cast<long long>(0xFF00000000000000ULL)));
+				const __m128i dists = _mm_srai_epi32(_mm_slli_epi64(v, 8), 24);
+				const __m128i probe = _mm_add_epi32(_mm_set1_epi64x(static_cast<long long>(static_cast<std::uint64_t>(dist) << 32U)), _mm_set_epi64x(1LL << 32, 0));
+				match = static_cast<unsigned>(
+				  _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi32(hashes, _mm_set1_epi64x(static_cast<long long>(static_cast<std::uint64_t>(h) << 56U))))));
+				const unsigned stop = static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi32(probe, dists))));
+#endif
+				return stop ? bit_scan_forward_32(stop) : group_size;
+			}
+#else
+			static constexpr unsigned group_size = 0;
+#endif
 		};
 
 #else
@@ -171,6 +220,8 @@ namespace seq
 				_dist = tombstone;
 			}
 			SEQ_ALWAYS_INLINE void set_distance(dist_type dist) noexcept { _dist = static_cast<char>(dist); }
+			// No group probing for this layout
+			static constexpr unsigned group_size = 0;
 		};
 
 #endif
@@ -429,7 +480,7 @@ namespace seq
 						node_type n = node_type(static_cast<tiny_hash>(h), static_cast<dist_type>(dist), it.as_uint());
 						std::swap(n, d_buckets[index]);
 						if (dist)
-							start_insert(d_buckets, bsize, index, static_cast<dist_type>(dist), n);
+							start_insert(d_buckets, new_hash_mask, index, static_cast<dist_type>(dist), n);
 					}
 					++it;
 				}
@@ -601,6 +652,259 @@ namespace seq
 				}
 			}
 
+			template<class ExecPolicy>
+			void rehash_parallel(ExecPolicy&& p, size_t size = 0)
+			{
+				// Parallel version of rehash().
+				// Nodes are partitioned based on the highest bits of their bucket index, so that each partition
+				// owns a contiguous slice of the bucket array and can be built without synchronization.
+				// Nodes pushed past the end of their slice are inserted sequentially afterward.
+				// Duplicates always belong to the same partition, and are removed per partition in insertion order.
+
+				struct entry
+				{
+					std::uintptr_t iter;
+					size_t hash;
+				};
+				struct batch
+				{
+					const_iterator first, last;
+					size_t count;
+					std::vector<entry> entries;  // entries sorted by partition
+					std::vector<size_t> offsets; // partition offsets in entries
+				};
+				struct partition
+				{
+					std::vector<node_type> overflow;	 // nodes pushed past the slice end
+					std::vector<std::uintptr_t> duplicates; // duplicate values to erase
+					int max_dist = 0;
+				};
+
+				const bool remove_duplicates = dirty();
+				const size_t count = this->size();
+				if (size == 0)
+					size = static_cast<size_t>(static_cast<double>(count) / static_cast<double>(d_load_factor));
+
+				// Sequenced policy, small tables and linear hashing use the sequential path
+				if constexpr (std::is_same_v<std::decay_t<ExecPolicy>, std::execution::sequenced_policy>)
+					return rehash(size, true);
+				if (count < (1ULL << 15U) || size < (1ULL << 14U) || d_max_dist == node_type::max_distance)
+					return rehash(size, true);
+
+				size_t new_hash_mask;
+				if ((size & (size - 1ULL)) == 0ULL)
+					new_hash_mask = size - 1ULL;
+				else
+					new_hash_mask = (1ULL << (1ULL + (bit_scan_reverse_64(size)))) - 1ULL;
+				const size_t new_hash_len = bit_scan_reverse_64(new_hash_mask) + 1U;
+				if (!remove_duplicates && new_hash_mask == d_hash_mask)
+					return;
+
+				// Up to 256 partitions of at least 4096 buckets
+				const unsigned part_bits = std::min(8U, static_cast<unsigned>(new_hash_len) - 12U);
+				const size_t part_count = 1ULL << part_bits;
+				const unsigned part_shift = static_cast<unsigned>(new_hash_len) - part_bits;
+
+				// Split the sequence in batches of whole chunks
+				std::vector<batch> batches;
+				{
+					const size_t target = std::max(static_cast<size_t>(4096), count / (part_count * 2));
+					const_iterator last = d_seq.cend();
+					auto* chunk = d_seq.cbegin().node;
+					while (chunk != last.node) {
+						batch b;
+						b.first = const_iterator(chunk);
+						b.count = 0;
+						while (chunk != last.node && b.count < target) {
+							b.count += chunk->size();
+							chunk = static_cast<decltype(chunk)>(chunk->next);
+						}
+						b.last = const_iterator(chunk);
+						batches.push_back(std::move(b));
+					}
+				}
+				std::vector<partition> parts(part_count);
+
+				std::mutex lock;
+				std::exception_ptr error;
+				auto capture = [&]() {
+					std::lock_guard<std::mutex> l(lock);
+					if (!error)
+						error = std::current_exception();
+				};
+
+				// Hash values and sort them by partition within each batch
+				std::for_each(p, batches.begin(), batches.end(), [&](batch& b) {
+					try {
+						std::vector<entry> tmp(b.count);
+						b.offsets.assign(part_count + 1, 0);
+						size_t i = 0;
+						for (const_iterator it = b.first; it != b.last; ++it, ++i) {
+							const size_t hash = hash_key(extract_key::key(*it));
+							tmp[i] = entry{ it.as_uint(), hash };
+							++b.offsets[((hash & new_hash_mask) >> part_shift) + 1];
+						}
+						for (size_t j = 1; j <= part_count; ++j)
+							b.offsets[j] += b.offsets[j - 1];
+						std::vector<size_t> pos(b.offsets.begin(), b.offsets.end() - 1);
+						b.entries.resize(b.count);
+						for (const entry& e : tmp)
+							b.entries[pos[(e.hash & new_hash_mask) >> part_shift]++] = e;
+					}
+					catch (...) {
+						capture();
+					}
+				});
+				if (error)
+					std::rethrow_exception(error);
+
+				try {
+					free_buckets(d_buckets);
+					d_buckets = null_node();
+					d_next_target = d_hash_mask = d_hash_len = 0;
+					d_max_dist = 1;
+					d_buckets = make_buckets((new_hash_mask + 1ULL));
+					d_hash_mask = new_hash_mask;
+					d_hash_len = new_hash_len;
+				}
+				catch (...) {
+					mark_dirty();
+					throw;
+				}
+
+				// Build each slice of the bucket array
+				std::atomic<bool> too_far{ false };
+				std::vector<size_t> part_ids(part_count);
+				for (size_t i = 0; i < part_count; ++i)
+					part_ids[i] = i;
+				std::for_each(p, part_ids.begin(), part_ids.end(), [&](size_t id) {
+					try {
+						partition& part = parts[id];
+						node_type* buckets = d_buckets;
+						const size_t end = (id + 1) << part_shift;
+						for (const batch& b : batches) {
+							for (size_t i = b.offsets[id]; i != b.offsets[id + 1]; ++i) {
+								const entry& e = b.entries[i];
+								const tiny_hash h = node_type::small_hash(e.hash);
+								size_t index = e.hash & new_hash_mask;
+								dist_type dist = 0;
+
+								if (remove_duplicates) {
+									// Look for an existing equal value, either in the slice or in the overflow nodes
+									const_iterator pos;
+									pos.from_uint(e.iter);
+									const auto& key = extract_key::key(*pos);
+									bool found = false;
+									size_t idx = index;
+									dist_type d = 0;
+									while (idx != end && d <= buckets[idx].distance()) {
+										if (h == buckets[idx].hash() && (*this)(extract_key::key(sequence_node_value(buckets[idx])), key)) {
+											found = true;
+											break;
+										}
+										++idx;
+										++d;
+									}
+									if (!found && idx == end) {
+										for (const node_type& n : part.overflow)
+											if (h == n.hash() && (*this)(extract_key::key(sequence_node_value(n)), key)) {
+												found = true;
+												break;
+											}
+									}
+									if (found) {
+										part.duplicates.push_back(e.iter);
+										continue;
+									}
+									index = idx;
+									dist = d;
+								}
+
+								// Robin-hood insertion bounded by the slice end
+								node_type cur(h, dist, e.iter);
+								for (;;) {
+									if (index == end) {
+										part.overflow.push_back(cur);
+										break;
+									}
+									if (buckets[index].distance() < cur.distance()) {
+										if (cur.distance() > part.max_dist)
+											part.max_dist = cur.distance();
+										if (buckets[index].distance() == -1) {
+											buckets[index] = cur;
+											break;
+										}
+										std::swap(buckets[index], cur);
+									}
+									++index;
+									if (cur.distance() + 1 >= node_type::max_distance) {
+										too_far.store(true);
+										return;
+									}
+									cur.set_distance(static_cast<dist_type>(cur.distance() + 1));
+								}
+							}
+						}
+					}
+					catch (...) {
+						capture();
+					}
+				});
+				if (error) {
+					mark_dirty();
+					std::rethrow_exception(error);
+				}
+
+				int max_dist = 1;
+				if (!too_far.load()) {
+					// Insert overflow nodes, starting at the beginning of the next slice
+					for (size_t id = 0; id < part_count && !too_far.load(); ++id) {
+						partition& part = parts[id];
+						max_dist = std::max(max_dist, part.max_dist);
+						for (node_type cur : part.overflow) {
+							size_t index = ((id + 1) << part_shift) & new_hash_mask;
+							for (;;) {
+								if (d_buckets[index].distance() < cur.distance()) {
+									max_dist = std::max(max_dist, static_cast<int>(cur.distance()));
+									if (d_buckets[index].distance() == -1) {
+										d_buckets[index] = cur;
+										break;
+									}
+									std::swap(d_buckets[index], cur);
+								}
+								index = (index + 1) & new_hash_mask;
+								if (cur.distance() + 1 >= node_type::max_distance) {
+									too_far.store(true);
+									break;
+								}
+								cur.set_distance(static_cast<dist_type>(cur.distance() + 1));
+							}
+							if (too_far.load())
+								break;
+						}
+					}
+				}
+				if (too_far.load()) {
+					// Bad hash function: fallback to the sequential path (switch to linear hashing)
+					if (remove_duplicates)
+						rehash_remove_duplicates(new_hash_mask, new_hash_len, d_seq.begin(), d_seq.end());
+					else
+						rehash(new_hash_mask, new_hash_len, d_seq.begin(), d_seq.end());
+					return;
+				}
+
+				// Erase duplicates from the sequence
+				for (const partition& part : parts)
+					for (std::uintptr_t it : part.duplicates) {
+						const_iterator pos;
+						pos.from_uint(it);
+						d_seq.erase(pos);
+					}
+
+				d_next_target = static_cast<size_t>(static_cast<double>(bucket_size()) * static_cast<double>(d_load_factor));
+				d_max_dist = max_dist;
+			}
+
 			template<class K>
 			SEQ_ALWAYS_INLINE auto hash_key(const K& key) const noexcept(noexcept(std::declval<Hash&>().operator()(std::declval<K&>()))) -> size_t
 			{
@@ -654,6 +958,40 @@ namespace seq
 				if SEQ_UNLIKELY(!robin_hood)
 					check_hash_operation();
 
+				if constexpr (node_type::group_size > 0) {
+					// Group probing: test group_size nodes at once for both the tiny hash and the end of the probe chain.
+					// Only used in robin-hood mode and when the group does not wrap around the end of the table.
+					if SEQ_LIKELY (robin_hood) {
+						// At usual load factors, most probe chains end within the first nodes: check them one by one
+						// and only switch to group probing for long probe chains.
+						for (; dist < node_type::group_start; ++dist) {
+							if (dist > it->distance())
+								return d_seq.end();
+							if (h == it->hash() && (*this)(extract_key::key(sequence_node_value(*it)), key))
+								return const_iterator(it->node(), it->pos());
+							it = it == end ? d_buckets : it + 1;
+						}
+						while (end - it >= static_cast<std::ptrdiff_t>(node_type::group_size - 1)) {
+							unsigned match;
+							const unsigned stop = node_type::probe_group(it, h, dist, match);
+							match &= (1U << stop) - 1U;
+							while (match) {
+								const auto* n = it + bit_scan_forward_32(match);
+								if ((*this)(extract_key::key(sequence_node_value(*n)), key))
+									return const_iterator(n->node(), n->pos());
+								match &= match - 1U;
+							}
+							if (stop != node_type::group_size)
+								return d_seq.end();
+							it += node_type::group_size;
+							dist += static_cast<dist_type>(node_type::group_size);
+						}
+						// Wrap around
+						if (it > end)
+							it = d_buckets;
+					}
+				}
+
 				while (!(dist > it->distance())) {
 					// Check for equality (first the hash part and then the key itself).
 					if (h == it->hash() && (*this)(extract_key::key(sequence_node_value(*it)), key))
@@ -854,6 +1192,49 @@ namespace seq
 				return 1;
 			}
 
+			template<Location loc>
+			auto relink(const_iterator it) -> iterator
+			{
+				// Move the value pointed by it to the back (or front) of the sequence.
+				// The hash table node is updated in place: no probing, no robin-hood displacement, no rehash.
+
+				SEQ_ASSERT_DEBUG(it != d_seq.end(), "invalid relink position");
+				check_hash_operation();
+
+				if constexpr (loc == Back) {
+					if (std::next(it) == d_seq.cend())
+						return static_cast<iterator>(it);
+				}
+				else {
+					if (it == d_seq.cbegin())
+						return static_cast<iterator>(it);
+				}
+
+				node_type* n = find_node(hash_key(extract_key::key(*it)), it);
+				iterator res = InsertPolicy<loc>::emplace(d_seq, std::move(const_cast<Value&>(*it)));
+				*n = node_type(n->hash(), n->distance(), res.as_uint());
+				d_seq.erase(it);
+				return res;
+			}
+
+			auto compact_step(size_t max_moves) -> size_t
+			{
+				// Merge sparse chunks of the sequence, and update the nodes of moved values in place
+				if (dirty())
+					return d_seq.compact_step(max_moves);
+				try {
+					return d_seq.compact_step(max_moves, [this](const const_iterator& from, const iterator& to) {
+						node_type* n = find_node(hash_key(extract_key::key(*to)), from);
+						*n = node_type(n->hash(), n->distance(), to.as_uint());
+					});
+				}
+				catch (...) {
+					// Some nodes might point to moved values
+					mark_dirty();
+					throw;
+				}
+			}
+
 			auto erase(const_iterator first, const_iterator last) -> iterator
 			{
 				// Erase range of iterators. Most of the checks are performed in sequence::erase().
@@ -1251,6 +1632,18 @@ namespace seq
 		///
 		void rehash() { this->base_type::rehash(); }
 		void rehash(size_t n) { this->base_type::rehash(n); }
+		/// @brief Parallel version of rehash().
+		/// @param p execution policy (like std::execution::par)
+		/// @param n new hash table size (0 to use the current size and maximum load factor)
+		/// Values are hashed concurrently, and the hash table is split in independent slices built concurrently.
+		/// Duplicates are removed in insertion order, like rehash(). This is mostly useful after bulk inserting values through sequence().
+		/// The hash function and the equality comparison are called concurrently, and about 16 additional bytes per value are allocated during the operation.
+		/// std::execution::seq, small tables and tables in linear hashing state use the sequential rehash().
+		template<class ExecPolicy, class = std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecPolicy>>>>
+		void rehash(ExecPolicy&& p, size_t n = 0)
+		{
+			this->base_type::rehash_parallel(std::forward<ExecPolicy>(p), n);
+		}
 
 		/// @brief Sets the number of nodes to the number needed to accomodate at least count elements without exceeding maximum load factor and rehashes the container.
 		/// @param count new capacity of the container
@@ -1290,6 +1683,15 @@ namespace seq
 			rehash();
 		}
 
+		/// @brief Incremental version of shrink_to_fit(), calls seq::sequence::compact_step().
+		/// Merges adjacent sparse chunks of the underlying sequence, moving at most max_moves values.
+		/// The hash table nodes of moved values are updated in place, without rehash.
+		/// Returns the number of moved values, 0 if the sequence cannot be compacted further.
+		/// This can be used to spread the compaction cost over idle time slices after many erasures.
+		/// Only invalidates references and iterators to moved values.
+		/// Basic exception guarantee only: if an exception is thrown, the container must be rehashed with rehash().
+		auto compact_step(size_t max_moves) -> size_t { return this->base_type::compact_step(max_moves); }
+
 		/// @brief Swap this container with other
 		void swap(ordered_set& other) noexcept(noexcept(std::declval<base_type&>().swap(std::declval<base_type&>()))) { base_type::swap(other); }
 
@@ -1415,6 +1817,19 @@ namespace seq
 		/// and a bool denoting whether the insertion took place (true if insertion happened, false if it did not).
 		SEQ_ALWAYS_INLINE auto push_front(value_type&& value) -> std::pair<iterator, bool> { return this->base_type::template emplace<detail::Front>(std::move(value)); }
 
+		/// @brief Move the element at pos to the back of the container.
+		/// The element is moved within the underlying sequence and its hash table node is updated in place, without probing or rehashing.
+		/// Only iterators and references to the moved element are invalidated.
+		/// @param pos iterator to the element to move
+		/// @return iterator to the moved element
+		SEQ_ALWAYS_INLINE auto move_to_back(const_iterator pos) -> iterator { return this->base_type::template relink<detail::Back>(pos); }
+		/// @brief Move the element at pos to the front of the container.
+		/// The element is moved within the underlying sequence and its hash table node is updated in place, without probing or rehashing.
+		/// Only iterators and references to the moved element are invalidated.
+		/// @param pos iterator to the element to move
+		/// @return iterator to the moved element
+		SEQ_ALWAYS_INLINE auto move_to_front(const_iterator pos) -> iterator { return this->base_type::template relink<detail::Front>(pos); }
+
 		/// @brief Erase element at given location.
 		/// Iterators and references are not invalidated. Rehashing never occurs.
 		/// @param pos iterator to the element to erase
@@ -1685,6 +2100,12 @@ namespace seq
 		void clear() { this->base_type::clear(); }
 		void rehash() { this->base_type::rehash(); }
 		void rehash(size_t n) { this->base_type::rehash(n); }
+		/// @brief Parallel version of rehash(), see ordered_set::rehash(ExecPolicy&&, size_t)
+		template<class ExecPolicy, class = std::enable_if_t<std::is_execution_policy_v<std::decay_t<ExecPolicy>>>>
+		void rehash(ExecPolicy&& p, size_t n = 0)
+		{
+			this->base_type::rehash_parallel(std::forward<ExecPolicy>(p), n);
+		}
 		void reserve(size_t size) { this->base_type::reserve(size); }
 		template<class Less>
 		void sort(Less le)
@@ -1713,6 +2134,8 @@ namespace seq
 			sequence().shrink_to_fit();
 			this->base_type::rehash();
 		}
+		/// @brief Incremental version of shrink_to_fit(), see ordered_set::compact_step()
+		auto compact_step(size_t max_moves) -> size_t { return this->base_type::compact_step(max_moves); }
 
 		void swap(ordered_map& other) noexcept(noexcept(std::declval<base_type&>().swap(std::declval<base_type&>()))) { base_type::swap(other); }
 
@@ -1870,6 +2293,19 @@ namespace seq
 			return this->base_type::template emplace<detail::Front>(Policy::make(std::forward<P>(value)));
 		}
 
+		/// @brief Move the element at pos to the back of the container.
+		/// The element is moved within the underlying sequence and its hash table node is updated in place, without probing or rehashing.
+		/// Only iterators and references to the moved element are invalidated.
+		/// @param pos iterator to the element to move
+		/// @return iterator to the moved element
+		SEQ_ALWAYS_INLINE auto move_to_back(const_iterator pos) -> iterator { return this->base_type::template relink<detail::Back>(pos); }
+		/// @brief Move the element at pos to the front of the container.
+		/// The element is moved within the underlying sequence and its hash table node is updated in place, without probing or rehashing.
+		/// Only iterators and references to the moved element are invalidated.
+		/// @param pos iterator to the element to move
+		/// @return iterator to the moved element
+		SEQ_ALWAYS_INLINE auto move_to_front(const_iterator pos) -> iterator { return this->base_type::template relink<detail::Front>(pos); }
+
 		template<class... Args>
 		SEQ_ALWAYS_INLINE auto try_emplace(const Key& k, Args&&... args) -> std::pair<iterator, bool>
 		{
@@ -2099,6 +2535,215 @@ namespace seq
 		return count;
 	}
 
+	/// @brief Default cost function for seq::lru_ordered_map: each entry costs sizeof(value_type) bytes
+	struct lru_default_cost
+	{
+		template<class V>
+		auto operator()(const V& /*unused*/) const noexcept -> size_t
+		{
+			return sizeof(V);
+		}
+	};
+
+	/// @brief Bounded-capacity LRU map built on top of seq::ordered_map.
+	/// @tparam Key Key type
+	/// @tparam T mapped type
+	/// @tparam Hash Hash function
+	/// @tparam KeyEqual Equality comparison function
+	/// @tparam Cost function returning the cost in bytes of a std::pair<Key,T>
+	/// @tparam Allocator allocator object
+	///
+	/// lru_ordered_map uses the insertion order of seq::ordered_map as recency order: the front element is the least recently used one,
+	/// the back element is the most recently used one.
+	///
+	/// Accessing an element with find(), get(), operator[], try_emplace() or insert_or_assign() moves it to the back using ordered_map::move_to_back(),
+	/// which updates its hash table node in place. Inserting a new element evicts elements from the front until both the size and the byte budget
+	/// are respected (the most recently inserted element is never evicted).
+	///
+	/// The cost of an entry is computed on insertion and assignment. Modifying a value in place through an iterator must not change its cost.
+	///
+	/// Since moving elements leaves holes in the underlying seq::sequence, the sequence is compacted when its capacity exceeds twice its size.
+	/// This invalidates iterators, and only happens on insertion of new elements.
+	///
+	template<class Key, class T, class Hash = hasher<Key>, class KeyEqual = std::equal_to<>, class Cost = lru_default_cost, class Allocator = std::allocator<std::pair<Key, T>>>
+	class lru_ordered_map
+	{
+	public:
+		using map_type = ordered_map<Key, T, Hash, KeyEqual, Allocator>;
+		using iterator = typename map_type::iterator;
+		using const_iterator = typename map_type::const_iterator;
+		using key_type = Key;
+		using mapped_type = T;
+		using value_type = typename map_type::value_type;
+		using size_type = size_t;
+		using hasher = Hash;
+		using key_equal = KeyEqual;
+		using allocator_type = Allocator;
+
+	private:
+		map_type d_map;
+		size_t d_max_size;
+		size_t d_max_bytes;
+		size_t d_bytes;
+		Cost d_cost;
+
+		void remove_cost(const value_type& v) noexcept
+		{
+			size_t c = d_cost(v);
+			d_bytes -= c < d_bytes ? c : d_bytes;
+		}
+		void compact()
+		{
+			// Remove holes left by move_to_back()
+			if (d_map.csequence().capacity() > 2 * d_map.size() + 128)
+				d_map.shrink_to_fit();
+		}
+		void evict()
+		{
+			while (d_map.size() > 1 && (d_map.size() > d_max_size || d_bytes > d_max_bytes))
+				pop_front();
+		}
+
+	public:
+		/// @brief Construct an empty lru_ordered_map
+		/// @param max_size maximum number of elements (at least 1)
+		/// @param max_bytes maximum total cost of elements
+		/// @param cost cost function
+		explicit lru_ordered_map(size_t max_size,
+					 size_t max_bytes = std::numeric_limits<size_t>::max(),
+					 const Cost& cost = Cost(),
+					 const Hash& hash = Hash(),
+					 const KeyEqual& equal = KeyEqual(),
+					 const Allocator& alloc = Allocator())
+		  : d_map(hash, equal, alloc)
+		  , d_max_size(max_size ? max_size : 1)
+		  , d_max_bytes(max_bytes)
+		  , d_bytes(0)
+		  , d_cost(cost)
+		{
+		}
+
+		/// @brief Returns the underlying ordered_map
+		auto map() const noexcept -> const map_type& { return d_map; }
+		/// @brief Returns the number of elements
+		auto size() const noexcept -> size_t { return d_map.size(); }
+		/// @brief Returns true if the container is empty
+		auto empty() const noexcept -> bool { return d_map.size() == 0; }
+		/// @brief Returns the total cost of stored elements
+		auto bytes() const noexcept -> size_t { return d_bytes; }
+		/// @brief Returns the maximum number of elements
+		auto max_size() const noexcept -> size_t { return d_max_size; }
+		/// @brief Returns the maximum total cost of elements
+		auto max_bytes() const noexcept -> size_t { return d_max_bytes; }
+		/// @brief Set the maximum number of elements and total cost, evicting least recently used elements if necessary
+		void set_capacity(size_t max_size, size_t max_bytes = std::numeric_limits<size_t>::max())
+		{
+			d_max_size = max_size ? max_size : 1;
+			d_max_bytes = max_bytes;
+			evict();
+		}
+
+		/// @brief Returns iterator to the least recently used element
+		auto begin() noexcept -> iterator { return d_map.begin(); }
+		auto begin() const noexcept -> const_iterator { return d_map.begin(); }
+		auto end() noexcept -> iterator { return d_map.end(); }
+		auto end() const noexcept -> const_iterator { return d_map.end(); }
+
+		/// @brief Mark element at pos as most recently used
+		/// @return iterator to the element
+		auto touch(const_iterator pos) -> iterator { return d_map.move_to_back(pos); }
+
+		/// @brief Finds an element and mark it as most recently used
+		/// @return iterator to the element on success, end iterator on failure
+		auto find(const Key& key) -> iterator
+		{
+			auto it = d_map.find(key);
+			return it == d_map.end() ? it : touch(it);
+		}
+		/// @brief Finds an element without changing the recency order
+		auto peek(const Key& key) const -> const_iterator { return d_map.find(key); }
+		/// @brief Returns true if the key exists, without changing the recency order
+		auto contains(const Key& key) const -> bool { return d_map.contains(key); }
+		/// @brief Returns a pointer to the mapped value and mark it as most recently used, or nullptr if the key does not exist
+		auto get(const Key& key) -> T*
+		{
+			auto it = find(key);
+			return it == d_map.end() ? nullptr : &it->second;
+		}
+
+		/// @brief Inserts a new element at the back if the key does not exist, or mark the existing element as most recently used.
+		/// Might evict least recently used elements.
+		/// @return pair of iterator to the element and bool denoting whether the insertion took place
+		template<class K, class... Args>
+		auto try_emplace(K&& key, Args&&... args) -> std::pair<iterator, bool>
+		{
+			auto it = d_map.find(key);
+			if (it != d_map.end())
+				return std::pair<iterator, bool>(touch(it), false);
+			compact();
+			auto res = d_map.try_emplace_back(std::forward<K>(key), std::forward<Args>(args)...);
+			d_bytes += d_cost(*res.first);
+			evict();
+			return res;
+		}
+		/// @brief Inserts a new element at the back, or assign and mark the existing element as most recently used.
+		/// Might evict least recently used elements.
+		/// @return pair of iterator to the element and bool denoting whether the insertion took place
+		template<class K, class M>
+		auto insert_or_assign(K&& key, M&& obj) -> std::pair<iterator, bool>
+		{
+			auto it = d_map.find(key);
+			if (it != d_map.end()) {
+				remove_cost(*it);
+				it->second = std::forward<M>(obj);
+				d_bytes += d_cost(*it);
+				it = touch(it);
+				evict();
+				return std::pair<iterator, bool>(it, false);
+			}
+			compact();
+			auto res = d_map.try_emplace_back(std::forward<K>(key), std::forward<M>(obj));
+			d_bytes += d_cost(*res.first);
+			evict();
+			return res;
+		}
+		/// @brief Returns the value mapped to key (default constructed if it does not exist) and mark it as most recently used
+		auto operator[](const Key& key) -> T& { return try_emplace(key).first->second; }
+		/// @brief Returns the value mapped to key (default constructed if it does not exist) and mark it as most recently used
+		auto operator[](Key&& key) -> T& { return try_emplace(std::move(key)).first->second; }
+
+		/// @brief Removes the least recently used element
+		void pop_front()
+		{
+			SEQ_ASSERT_DEBUG(size() > 0, "pop_front() on empty lru_ordered_map");
+			auto it = d_map.begin();
+			remove_cost(*it);
+			d_map.erase(it);
+		}
+		/// @brief Erase element at given location
+		auto erase(const_iterator pos) -> iterator
+		{
+			remove_cost(*pos);
+			return d_map.erase(pos);
+		}
+		/// @brief Erase element comparing equal to given key (if any)
+		/// @return number of erased elements (0 or 1)
+		auto erase(const Key& key) -> size_t
+		{
+			auto it = d_map.find(key);
+			if (it == d_map.end())
+				return 0;
+			erase(it);
+			return 1;
+		}
+		/// @brief Clear the container
+		void clear()
+		{
+			d_map.clear();
+			d_bytes = 0;
+		}
+	};
+
 } // end namespace seq
 
 #endif
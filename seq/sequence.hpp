@@ -770,10 +770,12 @@ namespace seq
 			using chunk_type = detail::list_chunk<T>;
 			detail::base_list_chunk<T> end; // end chunk
 			std::size_t size;		// full size
+			chunk_type* compact_cursor;	// next chunk visited by compact_step(), null to start from the front
 
 			Data(const Allocator& al) noexcept(std::is_nothrow_copy_constructible_v<Allocator>)
 			  : layout_manager(al)
 			  , size(0)
+			  , compact_cursor(nullptr)
 			{
 				endNode()->prev = endNode()->next = endNode();
 				endNode()->prev_free = endNode()->next_free = endNode();
@@ -785,6 +787,14 @@ namespace seq
 			SEQ_ALWAYS_INLINE auto endNode() noexcept -> chunk_type* { return static_cast<chunk_type*>(&end); }
 			SEQ_ALWAYS_INLINE auto endNode() const noexcept -> const chunk_type* { return static_cast<const chunk_type*>(&end); }
 
+			void deallocate_chunk(chunk_type* chunk)
+			{
+				// Restart compaction from the front if the cursor chunk is released
+				if (chunk == compact_cursor)
+					compact_cursor = nullptr;
+				layout_manager::deallocate_chunk(chunk);
+			}
+
 			void shrink_to_fit(std::vector<chunk_type*>* vec_chunk = nullptr)
 			{
 				// Compact sequence by shifting left all values and remove holes produced by calls to erase()
@@ -912,6 +922,9 @@ namespace seq
 					if (node->start == node->end) {
 						_del = node;
 						last = static_cast<chunk_type*>(node->prev);
+						// The empty node might have been added to vec_chunk when crossing the last chunk boundary
+						if (vec_chunk && !vec_chunk->empty() && vec_chunk->back() == node)
+							vec_chunk->pop_back();
 					}
 
 					last->next = endNode();
@@ -1027,6 +1040,65 @@ namespace seq
 			node->used = 0;
 		}
 
+		static void update_bounds(chunk_type* node) noexcept
+		{
+			// Recompute start and end from the used mask
+			if (node->used == 0)
+				node->start = node->end = 0;
+			else {
+				node->start = static_cast<int>(bit_scan_forward_64(node->used));
+				node->end = static_cast<int>(bit_scan_reverse_64(node->used)) + 1;
+			}
+		}
+
+		template<class Fun>
+		auto compact_move(chunk_type* src, chunk_type* dst, size_t dst_pos, size_t max_moves, Fun& on_move) -> size_t
+		{
+			// Move the values of src, in order, to the consecutive slots of dst starting at dst_pos.
+			// Values of src already at their destination are left untouched. Stops after max_moves moves.
+			// Returns the number of moved values.
+			const bool src_full = src->used == full;
+			const bool dst_full = dst->used == full;
+			size_t moves = 0;
+			std::uint64_t used = src->used;
+			try {
+				while (used && moves < max_moves) {
+					std::uint64_t from = bit_scan_forward_64(used);
+					used &= used - 1;
+					if (src == dst && from == dst_pos) {
+						++dst_pos;
+						continue;
+					}
+					T* p = src->buffer() + from;
+					construct_ptr(dst->buffer() + dst_pos, std::move(*p));
+					dst->used |= 1ULL << dst_pos;
+					destroy_ptr(p);
+					src->used &= ~(1ULL << from);
+					++moves;
+					on_move(const_iterator(src, static_cast<int>(from)), iterator(dst, static_cast<int>(dst_pos)));
+					++dst_pos;
+				}
+			}
+			catch (...) {
+				compact_finish(src, dst, src_full, dst_full);
+				throw;
+			}
+			compact_finish(src, dst, src_full, dst_full);
+			return moves;
+		}
+		void compact_finish(chunk_type* src, chunk_type* dst, bool src_full, bool dst_full) noexcept
+		{
+			// Restore chunk bounds and free list after compact_move()
+			update_bounds(src);
+			if (src != dst) {
+				update_bounds(dst);
+				if (src_full && src->used != full)
+					add_free_node(src);
+				if (!dst_full && dst->used == full)
+					remove_free_node(dst);
+			}
+		}
+
 		template<class... Args>
 		SEQ_ALWAYS_INLINE auto emplace_anywhere(Args&&... args) -> iterator
 		{
@@ -1520,7 +1592,7 @@ namespace seq
 		SEQ_ALWAYS_INLINE auto empty() const noexcept -> bool { return !d_data || d_data->size == 0; }
 
 		/// @brief Returns the number of elements that the container has currently allocated space for.
-		SEQ_ALWAYS_INLINE auto capacity() const noexcept -> size_t { return d_data ? d_data->get_capacity() * 64ULL : 0; }
+		SEQ_ALWAYS_INLINE auto capacity() const noexcept -> size_t { return d_data ? d_data->get_capacity() * chunk_type::count : 0; }
 
 		/// @brief Returns the back sequence value.
 		SEQ_ALWAYS_INLINE auto back() const noexcept -> const T&
@@ -2002,6 +2074,64 @@ namespace seq
 				d_data->shrink_to_fit();
 		}
 
+		/// @brief Incremental and bounded version of shrink_to_fit().
+		/// @param max_moves maximum number of values moved by this call
+		/// @param on_move function called after each move with the old position (const_iterator) and the new position (iterator) of the value
+		/// @return number of moved values, 0 if the sequence cannot be compacted further
+		///
+		/// Walks the chunks from the position reached by the previous call, and merges each pair of adjacent chunks
+		/// whose values fit in a single chunk: the values of the first chunk are packed to its beginning, followed by the values
+		/// of the second chunk which is then released. Order of values is preserved, and a chunk holding too many values
+		/// to be merged is never touched, so the cost of a call is bounded by max_moves, plus a scan of the chunk masks.
+		/// When the end of the sequence is reached, the next call starts again from the front.
+		///
+		/// Once compact_step() returns 0, every pair of adjacent chunks holds more than 64 values (or the chunk capacity),
+		/// meaning that the sequence uses less than twice the memory of a fully packed one.
+		///
+		/// Only references and iterators to moved values are invalidated (on_move can be used to track them),
+		/// as well as iterators to the end of a released chunk. Never allocates memory.
+		/// Basic exception guarantee.
+		template<class Fun>
+		auto compact_step(size_t max_moves, Fun&& on_move) -> size_t
+		{
+			if (!d_data || d_data->size == 0 || max_moves == 0)
+				return 0;
+			chunk_type* end = d_data->endNode();
+			size_t moves = 0;
+			for (int pass = d_data->compact_cursor ? 0 : 1; pass < 2; ++pass) {
+				chunk_type* a = d_data->compact_cursor ? d_data->compact_cursor : static_cast<chunk_type*>(end->next);
+				while (a != end && moves < max_moves) {
+					chunk_type* b = static_cast<chunk_type*>(a->next);
+					if (b == end)
+						break;
+					size_t sa = a->size();
+					if (sa + b->size() > count) {
+						a = b;
+						continue;
+					}
+					// Pack a, then append b
+					moves += compact_move(a, a, 0, max_moves - moves, on_move);
+					if (moves < max_moves)
+						moves += compact_move(b, a, sa, max_moves - moves, on_move);
+					if (b->used == 0) {
+						remove_free_node(b);
+						remove_node(b);
+						d_data->deallocate_chunk(b);
+					}
+					// a might absorb its new neighbor as well
+				}
+				d_data->compact_cursor = (a == end || a->next == end) ? nullptr : a;
+				if (moves)
+					break;
+			}
+			return moves;
+		}
+		/// @brief Incremental and bounded version of shrink_to_fit(), see compact_step(size_t, Fun&&)
+		auto compact_step(size_t max_moves) -> size_t
+		{
+			return compact_step(max_moves, [](const_iterator, iterator) {});
+		}
+
 		/// @brief Increase the capacity of the vector to a value that's greater or equal to new_cap.
 		/// @param new_cap new capacity of the sequence
 		/// If new_cap is greater than the current capacity(), new storage is allocated, otherwise the function does nothing.
@@ -31,6 +31,10 @@
 #else
 #include <time.h>
 #endif
+#if defined(__linux__)
+#include <cstdio>
+#include <unistd.h>
+#endif
 
 #include <atomic>
 #include <chrono>
@@ -316,6 +320,16 @@ namespace seq
 			return /*memoryCounters.PrivateUsage + */ memoryCounters.WorkingSetSize;
 		}
 		return 0;
+#elif defined(__linux__)
+		// Resident set size
+		long pages = 0, resident = 0;
+		FILE* f = fopen("/proc/self/statm", "r");
+		if (!f)
+			return 0;
+		if (fscanf(f, "%ld %ld", &pages, &resident) != 2)
+			resident = 0;
+		fclose(f);
+		return static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
 #else
 		return 0;
 #endif
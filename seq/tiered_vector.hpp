@@ -3108,6 +3108,17 @@ namespace seq
 			}
 		}
 
+		/// @brief Select the bucket size for a container of count elements.
+		/// Unlike std::vector::reserve(), no memory is allocated. Subsequent insertions will still
+		/// adjust the bucket size to the actual container size, except when values are appended directly
+		/// through the bucket manager.
+		void reserve(size_type count)
+		{
+			make_manager_if_null();
+			if (count > size())
+				set_bucket_size(findBSize(count));
+		}
+
 		/// @brief Clear the container.
 		void clear() noexcept
 		{
@@ -296,6 +296,20 @@ namespace seq
 	{
 	};
 
+	/// @brief Check if allocator type provides the reallocate() and reallocate_front() members (see seq::mmap_allocator)
+	template<class A, class = void>
+	struct has_reallocate : std::false_type
+	{
+	};
+
+	template<class A>
+	struct has_reallocate<A,
+			      std::void_t<decltype(std::declval<A&>().reallocate(std::declval<typename A::value_type*>(), size_t(), std::declval<size_t&>())),
+					  decltype(std::declval<A&>().reallocate_front(std::declval<typename A::value_type*>(), size_t(), std::declval<size_t&>()))>>
+	  : std::true_type
+	{
+	};
+
 	template<class C>
 	struct is_iterable
 	{
@@ -28,10 +28,18 @@
 /** @file */
 
 #include <memory>
+#include <cstdlib>
+#include <cstring>
 
 #include "bits.hpp"
 #include "type_traits.hpp"
 
+#if defined(__linux__) && !defined(SEQ_NO_MREMAP)
+#define SEQ_HAS_MREMAP
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 namespace seq
 {
 
@@ -239,6 +247,212 @@ namespace seq
 		void destroy(T* p) { destroy_ptr(static_cast<T*>(p)); }
 	};
 
+	namespace detail
+	{
+		/// @brief Returns the system page size
+		inline auto page_size() noexcept -> size_t
+		{
+#ifdef SEQ_HAS_MREMAP
+			static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+			return size;
+#else
+			return 4096;
+#endif
+		}
+		/// @brief Round up given size in bytes to a multiple of the page size
+		inline auto page_round(size_t bytes) noexcept -> size_t
+		{
+			size_t p = page_size();
+			return (bytes + p - 1) & ~(p - 1);
+		}
+	}
+
+	/// @brief Allocator using anonymous memory mappings for large blocks.
+	/// @tparam T object type to allocate
+	/// @tparam Threshold size in bytes from which memory blocks are mapped instead of malloc'ed
+	///
+	/// mmap_allocator serves small blocks with malloc/free and large ones (at least \a Threshold bytes)
+	/// with page aligned anonymous mmap/munmap. On top of the standard allocator interface, it provides
+	/// 2 members used by seq::devector to grow its storage of relocatable types:
+	///	-	reallocate(p, n, new_n): grow a block, possibly in place. Large blocks are grown with mremap(MREMAP_MAYMOVE),
+	///		which only updates the page tables instead of copying the content.
+	///	-	reallocate_front(p, n, new_n): grow a large block at the front. A bigger region is reserved and the old pages
+	///		are remapped at its tail, so that old element i ends up at position new_n - n + i. Returns a null pointer
+	///		if the block cannot be remapped (small block, or page size not multiple of sizeof(T)), in which case
+	///		the input block is left untouched.
+	///
+	/// Both members might increase \a new_n to use the whole mapped pages. The content is moved bitwise,
+	/// so they should only be used for relocatable types. On failure, std::bad_alloc is thrown and the input block is still valid.
+	///
+	/// On platforms without mremap (anything but Linux, or if SEQ_NO_MREMAP is defined), all blocks are managed
+	/// with malloc/realloc/free and reallocate_front() always returns a null pointer.
+	///
+	template<class T, size_t Threshold = (1ULL << 20)>
+	class mmap_allocator
+	{
+		static_assert(alignof(T) <= alignof(std::max_align_t), "mmap_allocator does not support over aligned types");
+
+		static auto is_mapped(size_t bytes) noexcept -> bool
+		{
+#ifdef SEQ_HAS_MREMAP
+			return bytes != 0 && bytes >= Threshold;
+#else
+			(void)bytes;
+			return false;
+#endif
+		}
+		static auto map(size_t bytes) noexcept -> void*
+		{
+#ifdef SEQ_HAS_MREMAP
+			void* p = mmap(nullptr, detail::page_round(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			return p == MAP_FAILED ? nullptr : p;
+#else
+			(void)bytes;
+			return nullptr;
+#endif
+		}
+		static void unmap(void* p, size_t bytes) noexcept
+		{
+#ifdef SEQ_HAS_MREMAP
+			munmap(p, detail::page_round(bytes));
+#else
+			(void)p;
+			(void)bytes;
+#endif
+		}
+		static auto round_count(size_t bytes) noexcept -> size_t
+		{
+			// number of T fitting in the mapped pages, only if the round trip through deallocate() gives back the same pages
+			return sizeof(T) <= detail::page_size() ? detail::page_round(bytes) / sizeof(T) : bytes / sizeof(T);
+		}
+
+	public:
+		using value_type = T;
+		using pointer = T*;
+		using const_pointer = const T*;
+		using reference = T&;
+		using const_reference = const T&;
+		using size_type = size_t;
+		using difference_type = std::ptrdiff_t;
+		using propagate_on_container_swap = std::true_type;
+		using propagate_on_container_copy_assignment = std::true_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using is_always_equal = std::true_type;
+
+		template<class U>
+		struct rebind
+		{
+			using other = mmap_allocator<U, Threshold>;
+		};
+
+		mmap_allocator() noexcept {}
+		template<class U>
+		mmap_allocator(const mmap_allocator<U, Threshold>& /*unused*/) noexcept
+		{
+		}
+
+		auto operator==(const mmap_allocator& /*unused*/) const noexcept -> bool { return true; }
+		auto operator!=(const mmap_allocator& /*unused*/) const noexcept -> bool { return false; }
+
+		auto allocate(size_t n, const void* /*unused*/) -> T* { return allocate(n); }
+		auto allocate(size_t n) -> T*
+		{
+			size_t bytes = n * sizeof(T);
+			void* p = is_mapped(bytes) ? map(bytes) : std::malloc(bytes);
+			if (!p)
+				throw std::bad_alloc();
+			return static_cast<T*>(p);
+		}
+		void deallocate(T* p, size_t n) noexcept
+		{
+			if (!p)
+				return;
+			size_t bytes = n * sizeof(T);
+			if (is_mapped(bytes))
+				unmap(p, bytes);
+			else
+				std::free(p);
+		}
+
+		/// @brief Grow block \a p of \a n elements to \a new_n elements, possibly in place.
+		/// The first n elements are (bitwise) preserved. \a new_n might be increased to fill the last mapped page.
+		auto reallocate(T* p, size_t n, size_t& new_n) -> T*
+		{
+			if (!p)
+				return allocate(new_n);
+
+			size_t bytes = n * sizeof(T);
+			size_t new_bytes = new_n * sizeof(T);
+#ifdef SEQ_HAS_MREMAP
+			if (is_mapped(bytes) && is_mapped(new_bytes)) {
+				void* r = mremap(p, detail::page_round(bytes), detail::page_round(new_bytes), MREMAP_MAYMOVE);
+				if (r != MAP_FAILED) {
+					new_n = round_count(new_bytes);
+					return static_cast<T*>(r);
+				}
+				// mremap fails if the block spans several mappings (after reallocate_front()): copy instead
+			}
+#endif
+			if (!is_mapped(bytes) && !is_mapped(new_bytes)) {
+				void* r = std::realloc(static_cast<void*>(p), new_bytes);
+				if (!r)
+					throw std::bad_alloc();
+				return static_cast<T*>(r);
+			}
+			T* r = allocate(new_n);
+			memcpy(static_cast<void*>(r), static_cast<void*>(p), bytes < new_bytes ? bytes : new_bytes);
+			deallocate(p, n);
+			return r;
+		}
+
+		/// @brief Grow block \a p of \a n elements at the front to (at least) \a new_n elements.
+		/// On success, old element i is located at position new_n - n + i of the returned block.
+		/// Returns a null pointer if the block cannot be remapped.
+		auto reallocate_front(T* p, size_t n, size_t& new_n) -> T*
+		{
+#ifdef SEQ_HAS_MREMAP
+			size_t page = detail::page_size();
+			size_t bytes = n * sizeof(T);
+			if (!p || !is_mapped(bytes) || new_n <= n || page % sizeof(T) != 0)
+				return nullptr;
+
+			// the front growth must be a whole number of pages
+			size_t per_page = page / sizeof(T);
+			size_t front = (new_n - n + per_page - 1) / per_page * per_page;
+			size_t old_bytes = detail::page_round(bytes);
+			size_t total = front * sizeof(T) + old_bytes;
+
+			// reserve the whole region, then move the old pages at its tail
+			void* r = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (r == MAP_FAILED)
+				throw std::bad_alloc();
+			void* dst = static_cast<char*>(r) + front * sizeof(T);
+			if (mremap(p, old_bytes, old_bytes, MREMAP_MAYMOVE | MREMAP_FIXED, dst) == MAP_FAILED) {
+				munmap(r, total);
+				return nullptr;
+			}
+			new_n = front + n;
+			return static_cast<T*>(r);
+#else
+			(void)p;
+			(void)n;
+			(void)new_n;
+			return nullptr;
+#endif
+		}
+
+		template<class U, class... Args>
+		void construct(U* p, Args&&... args)
+		{
+			new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+		}
+		template<class U>
+		void destroy(U* p)
+		{
+			p->~U();
+		}
+	};
+
 	/// @brief Convenient random access iterator on a constant value
 	template<class T>
 	class cvalue_iterator
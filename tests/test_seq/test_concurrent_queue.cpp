@@ -0,0 +1,229 @@
+/**
+ * MIT License
+ *
+ * Copyright (c) 2025 Victor Moncada <vtr.moncada@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "seq/concurrent_queue.hpp"
+#include "seq/testing.hpp"
+#include "tests.hpp"
+
+#include <vector>
+#include <string>
+#include <thread>
+
+template<class T>
+T make_queue_value(size_t i)
+{
+	if constexpr (std::is_same_v<T, std::string>)
+		return std::to_string(i) + " a string long enough to allocate memory";
+	else
+		return T(i);
+}
+
+template<class Queue>
+void test_queue_logic()
+{
+	using value_type = typename Queue::value_type;
+	constexpr size_t count = seq::detail::list_chunk<value_type>::count;
+
+	Queue q;
+	value_type v;
+	SEQ_TEST(q.empty() && !q.try_pop(v));
+
+	// single push/pop across several chunks
+	for (size_t i = 0; i < count * 5 + 3; ++i)
+		q.push(make_queue_value<value_type>(i));
+	SEQ_TEST(q.size() == count * 5 + 3);
+	for (size_t i = 0; i < count * 5 + 3; ++i) {
+		SEQ_TEST(q.try_pop(v));
+		SEQ_TEST(v == make_queue_value<value_type>(i));
+	}
+	SEQ_TEST(q.empty() && !q.try_pop(v));
+
+	// batched push and pop
+	std::vector<value_type> in, out;
+	for (size_t i = 0; i < count * 7 + 5; ++i)
+		in.push_back(make_queue_value<value_type>(i));
+	q.push(in.begin(), in.begin() + 3);
+	q.push(in.begin() + 3, in.end());
+	SEQ_TEST(q.size() == in.size());
+	SEQ_TEST(q.try_pop(std::back_inserter(out), count + 1) == count + 1);
+	SEQ_TEST(q.try_pop(std::back_inserter(out), static_cast<size_t>(-1)) == in.size() - count - 1);
+	SEQ_TEST(out == in);
+	SEQ_TEST(q.try_pop(std::back_inserter(out), 10) == 0);
+
+	// consume
+	q.push(in.begin(), in.end());
+	out.clear();
+	SEQ_TEST(q.consume([&](value_type& val) { out.push_back(std::move(val)); }, 7) == 7);
+	SEQ_TEST(q.consume([&](value_type& val) { out.push_back(std::move(val)); }) == in.size() - 7);
+	SEQ_TEST(out == in && q.empty());
+
+	// leave some values in the queue: they must be destroyed with the queue
+	q.push(in.begin(), in.end());
+	q.emplace(make_queue_value<value_type>(1));
+}
+
+template<class T>
+void test_queue_recycle()
+{
+	// Once the queue reached its maximum size, pushing and popping must not allocate anymore.
+	// The chunk being read is recycled only when the consumer moves to the next one, so the footprint stabilizes after the second round.
+	using alloc_type = CountAlloc<T>;
+	constexpr size_t count = seq::detail::list_chunk<T>::count;
+	alloc_type al;
+	{
+		seq::spsc_queue<T, alloc_type> q(al);
+		std::vector<T> vals(count * 10);
+		for (size_t i = 0; i < vals.size(); ++i)
+			vals[i] = make_queue_value<T>(i);
+		std::vector<T> out;
+
+		for (size_t round = 0; round < 2; ++round) {
+			q.push(vals.begin(), vals.end());
+			q.try_pop(std::back_inserter(out), vals.size());
+		}
+		const std::int64_t bytes = get_alloc_bytes(al);
+		SEQ_TEST(bytes > 0);
+
+		for (size_t round = 0; round < 100; ++round) {
+			q.push(vals.begin(), vals.end());
+			out.clear();
+			SEQ_TEST(q.try_pop(std::back_inserter(out), vals.size()) == vals.size());
+			SEQ_TEST(out == vals);
+			SEQ_TEST(get_alloc_bytes(al) == bytes);
+		}
+	}
+	SEQ_TEST(get_alloc_bytes(al) == 0);
+}
+
+inline void test_spsc_threads(size_t count)
+{
+	// One producer pushing single values and ranges, one consumer popping them in order
+	seq::spsc_queue<size_t> q;
+	std::thread producer([&]() {
+		std::vector<size_t> batch;
+		for (size_t i = 0; i < count;) {
+			if ((i & 1023) < 512) {
+				q.push(i);
+				++i;
+			}
+			else {
+				batch.clear();
+				for (size_t j = 0; j < 100 && i < count; ++j, ++i)
+					batch.push_back(i);
+				q.push(batch.begin(), batch.end());
+			}
+		}
+	});
+
+	size_t expected = 0;
+	bool ok = true;
+	std::vector<size_t> out;
+	while (expected < count) {
+		size_t v;
+		if (expected & 1) {
+			if (q.try_pop(v)) {
+				ok = ok && v == expected;
+				++expected;
+			}
+			else
+				std::this_thread::yield();
+		}
+		else {
+			out.clear();
+			if (q.try_pop(std::back_inserter(out), 200) == 0)
+				std::this_thread::yield();
+			for (size_t val : out)
+				ok = ok && val == expected++;
+		}
+	}
+	producer.join();
+	SEQ_TEST(ok);
+	SEQ_TEST(q.empty());
+}
+
+inline void test_mpsc_threads(size_t producers, size_t count)
+{
+	// Several producers, each pushing increasing values tagged with its id.
+	// The consumer must see the values of each producer in order, and batches contiguously.
+	seq::mpsc_queue<std::pair<size_t, size_t>> q;
+	std::vector<std::thread> threads;
+	for (size_t p = 0; p < producers; ++p)
+		threads.emplace_back([&q, p, count]() {
+			std::vector<std::pair<size_t, size_t>> batch;
+			for (size_t i = 0; i < count;) {
+				if (i % 3) {
+					q.emplace(p, i);
+					++i;
+				}
+				else {
+					batch.clear();
+					for (size_t j = 0; j < 70 && i < count; ++j, ++i)
+						batch.emplace_back(p, i);
+					q.push(batch.begin(), batch.end());
+				}
+			}
+		});
+
+	std::vector<size_t> next(producers, 0);
+	size_t received = 0;
+	bool ok = true;
+	while (received < producers * count) {
+		size_t n = q.consume([&](const std::pair<size_t, size_t>& v) {
+			ok = ok && v.first < producers && v.second == next[v.first];
+			++next[v.first];
+		});
+		if (n == 0)
+			std::this_thread::yield();
+		received += n;
+	}
+	for (auto& t : threads)
+		t.join();
+	SEQ_TEST(ok);
+	SEQ_TEST(q.empty());
+	for (size_t n : next)
+		SEQ_TEST(n == count);
+}
+
+SEQ_PROTOTYPE(int test_concurrent_queue(int, char*[]))
+{
+	SEQ_TEST_MODULE_RETURN(spsc_queue, 1, test_queue_logic<seq::spsc_queue<size_t>>());
+	SEQ_TEST_MODULE_RETURN(mpsc_queue, 1, test_queue_logic<seq::mpsc_queue<size_t>>());
+	SEQ_TEST_MODULE_RETURN(spsc_queue_string, 1, test_queue_logic<seq::spsc_queue<std::string>>());
+
+	// Test queue and detect potential memory leak (including non destroyed objects)
+	SEQ_TEST_MODULE_RETURN(spsc_queue_destroy, 1, test_queue_logic<seq::spsc_queue<TestDestroy<size_t>>>());
+	SEQ_TEST(TestDestroy<size_t>::count() == 0);
+	SEQ_TEST_MODULE_RETURN(mpsc_queue_destroy, 1, test_queue_logic<seq::mpsc_queue<TestDestroy<size_t>>>());
+	SEQ_TEST(TestDestroy<size_t>::count() == 0);
+
+	// Test chunk recycling
+	SEQ_TEST_MODULE_RETURN(queue_recycle, 1, test_queue_recycle<size_t>());
+	SEQ_TEST_MODULE_RETURN(queue_recycle_wide, 1, test_queue_recycle<std::string>());
+
+	// Concurrent tests
+	SEQ_TEST_MODULE_RETURN(spsc_queue_threads, 1, test_spsc_threads(2000000));
+	SEQ_TEST_MODULE_RETURN(mpsc_queue_threads, 1, test_mpsc_threads(4, 500000));
+
+	return 0;
+}
@@ -26,6 +26,7 @@
 #include "seq/devector.hpp"
 #include "tests.hpp"
 #include <vector>
+#include <deque>
 
 template<class V1, class V2>
 bool vector_equals(const V1& v1, const V2& v2)
@@ -274,6 +275,175 @@ void test_devector_logic(const Alloc& al = Alloc())
 	}
 }
 
+template<class T, class Alloc>
+void test_devector_remap(size_t count)
+{
+	// Test growth through Alloc::reallocate() and Alloc::reallocate_front()
+	using namespace seq;
+
+	std::deque<T> d;
+	devector<T, Alloc> dv;
+
+	// interleaved push_back/push_front, values referencing the container itself
+	for (size_t i = 0; i < count; ++i) {
+		if (i & 1) {
+			d.push_back(static_cast<T>(i));
+			dv.push_back(static_cast<T>(i));
+		}
+		else {
+			d.push_front(static_cast<T>(i));
+			dv.push_front(static_cast<T>(i));
+		}
+		if ((i % 1000) == 999) {
+			d.push_back(d.front());
+			dv.push_back(dv.front());
+			d.push_front(d.back());
+			dv.push_front(dv.back());
+		}
+	}
+	SEQ_TEST(vector_equals(d, dv));
+
+	// front only
+	dv.clear();
+	d.clear();
+	for (size_t i = 0; i < count; ++i) {
+		d.push_front(static_cast<T>(i));
+		dv.push_front(static_cast<T>(i));
+	}
+	SEQ_TEST(vector_equals(d, dv));
+
+	// reserve
+	dv.reserve(dv.capacity() * 2);
+	SEQ_TEST(vector_equals(d, dv));
+	dv.reserve_front(dv.front_capacity() + count);
+	SEQ_TEST(dv.front_capacity() >= count);
+	SEQ_TEST(vector_equals(d, dv));
+	dv.reserve_back(dv.back_capacity() + count);
+	SEQ_TEST(dv.back_capacity() >= count);
+	SEQ_TEST(vector_equals(d, dv));
+
+	// resize_front
+	dv.resize_front(dv.size() + dv.front_capacity() + count, static_cast<T>(3));
+	d.insert(d.begin(), dv.size() - d.size(), static_cast<T>(3));
+	SEQ_TEST(vector_equals(d, dv));
+}
+
+template<class T, size_t N, class Alloc = std::allocator<T>>
+void test_small_devector_logic(const Alloc& al = Alloc())
+{
+	using namespace seq;
+	using small = small_devector<T, N, Alloc>;
+
+	std::deque<T> d;
+	small dv(al);
+
+	// stay inline
+	for (size_t i = 0; i < N; ++i) {
+		if (i & 1) {
+			d.push_back(static_cast<T>(i));
+			dv.push_back(static_cast<T>(i));
+		}
+		else {
+			d.push_front(static_cast<T>(i));
+			dv.push_front(static_cast<T>(i));
+		}
+	}
+	SEQ_TEST(dv.is_inline());
+	SEQ_TEST(vector_equals(d, dv));
+
+	// grow on the heap, with aliasing
+	for (size_t i = 0; i < 100; ++i) {
+		d.push_back(d.front());
+		dv.push_back(dv.front());
+		d.push_front(d.back());
+		dv.push_front(dv.back());
+	}
+	SEQ_TEST(!dv.is_inline());
+	SEQ_TEST(vector_equals(d, dv));
+
+	// random insert/erase
+	srand(0);
+	for (size_t i = 0; i < 500; ++i) {
+		size_t pos = static_cast<size_t>(rand()) % (d.size() + 1);
+		d.insert(d.begin() + static_cast<std::ptrdiff_t>(pos), static_cast<T>(i));
+		dv.insert(dv.begin() + pos, static_cast<T>(i));
+	}
+	SEQ_TEST(vector_equals(d, dv));
+	for (size_t i = 0; i < 400; ++i) {
+		size_t pos = static_cast<size_t>(rand()) % d.size();
+		d.erase(d.begin() + static_cast<std::ptrdiff_t>(pos));
+		dv.erase(dv.begin() + pos);
+	}
+	SEQ_TEST(vector_equals(d, dv));
+	d.erase(d.begin() + 10, d.begin() + 50);
+	dv.erase(dv.begin() + 10, dv.begin() + 50);
+	SEQ_TEST(vector_equals(d, dv));
+
+	// copy and move, heap storage
+	{
+		small c = dv;
+		SEQ_TEST(vector_equals(d, c));
+		small m = std::move(c);
+		SEQ_TEST(vector_equals(d, m));
+		SEQ_TEST(c.empty());
+		c = m;
+		SEQ_TEST(vector_equals(d, c));
+		c.swap(m);
+		SEQ_TEST(vector_equals(d, c));
+		SEQ_TEST(vector_equals(d, m));
+	}
+
+	// back to inline storage
+	d.resize(N / 2 + 1);
+	dv.resize(N / 2 + 1);
+	dv.shrink_to_fit();
+	SEQ_TEST(dv.is_inline());
+	SEQ_TEST(vector_equals(d, dv));
+
+	// copy and move, inline storage
+	{
+		small c(dv, al);
+		SEQ_TEST(vector_equals(d, c));
+		small m = std::move(c);
+		SEQ_TEST(vector_equals(d, m));
+		small h(200, static_cast<T>(1), al);
+		h.swap(m);
+		SEQ_TEST(vector_equals(d, h));
+		SEQ_TEST(m.size() == 200);
+		m = std::move(h);
+		SEQ_TEST(vector_equals(d, m));
+	}
+
+	// resize
+	d.resize(300, static_cast<T>(2));
+	dv.resize(300, static_cast<T>(2));
+	SEQ_TEST(vector_equals(d, dv));
+	d.insert(d.begin(), 50, static_cast<T>(3));
+	dv.resize_front(350, static_cast<T>(3));
+	SEQ_TEST(vector_equals(d, dv));
+	while (d.size() > 3) {
+		d.pop_front();
+		d.pop_back();
+		dv.pop_front();
+		dv.pop_back();
+	}
+	SEQ_TEST(vector_equals(d, dv));
+
+	// relocation of inline storage
+	if constexpr (is_relocatable<small>::value) {
+		devector<small> vec;
+		for (size_t i = 0; i < 100; ++i)
+			vec.emplace_back(i % (N + 2), static_cast<T>(i), al);
+		for (size_t i = 0; i < 100; ++i)
+			vec.emplace_front(vec.back());
+		for (size_t i = 0; i < vec.size(); ++i) {
+			size_t j = i < 100 ? 99 : i - 100;
+			std::deque<T> ref(j % (N + 2), static_cast<T>(j));
+			SEQ_TEST(vector_equals(ref, vec[i]));
+		}
+	}
+}
+
 #include "tests.hpp"
 
 SEQ_PROTOTYPE(int test_devector(int, char*[]))
@@ -294,5 +464,19 @@ SEQ_PROTOTYPE(int test_devector(int, char*[]))
 	SEQ_TEST(get_alloc_bytes(al2) == 0);
 	SEQ_TEST(TestDestroy<size_t>::count() == 0);
 
+	// Test devector growth with mremap, with small and large blocks
+	SEQ_TEST_MODULE_RETURN(devector_remap, 1, test_devector_remap<size_t, seq::mmap_allocator<size_t, 4096>>(200000));
+	SEQ_TEST_MODULE_RETURN(devector_remap_destroy, 1, test_devector_remap<TestDestroy<size_t>, seq::mmap_allocator<TestDestroy<size_t>, 4096>>(200000));
+	SEQ_TEST(TestDestroy<size_t>::count() == 0);
+
+	// Test small_devector and potential memory leak or wrong allocator propagation
+	CountAlloc<size_t> al3;
+	SEQ_TEST_MODULE_RETURN(small_devector, 1, (test_small_devector_logic<size_t, 8, CountAlloc<size_t>>(al3)));
+	SEQ_TEST(get_alloc_bytes(al3) == 0);
+	SEQ_TEST_MODULE_RETURN(small_devector_destroy, 1, (test_small_devector_logic<TestDestroy<size_t>, 5>()));
+	SEQ_TEST(TestDestroy<size_t>::count() == 0);
+	SEQ_TEST_MODULE_RETURN(small_devector_destroy_no_relocatable, 1, (test_small_devector_logic<TestDestroy<size_t, false>, 4>()));
+	SEQ_TEST(TestDestroy<size_t>::count() == 0);
+
 	return 0;
 }
@@ -25,6 +25,8 @@
 #include <map>
 #include <unordered_map>
 #include <set>
+#include <random>
+#include <limits>
 
 #include "seq/flat_map.hpp"
 #include "seq/testing.hpp"
@@ -952,6 +954,225 @@ void test_heavy_set(size_t count)
 	SEQ_TEST(s.size() == 0);
 }
 
+template<class K, class C, class A, bool S, bool U>
+void batch_insert(seq::flat_set<K, C, A, S, U>& s, const K& k)
+{
+	s.insert(k);
+}
+template<class K, class V, class C, class A, bool S, bool U>
+void batch_insert(seq::flat_map<K, V, C, A, S, U>& s, const K& k)
+{
+	s.emplace(k, V());
+}
+
+template<class Set, class Get>
+void test_find_batch(size_t count, Get get)
+{
+	using key_type = typename Set::key_type;
+	std::vector<key_type> keys(count);
+	for (size_t i = 0; i < count; ++i)
+		keys[i] = get(i);
+	seq::random_shuffle(keys.begin(), keys.end());
+
+	// Insert half of the keys one by one to get rotated buckets
+	Set s;
+	for (size_t i = 0; i < count; i += 2)
+		batch_insert(s, keys[i]);
+
+	std::vector<size_t> pos(count);
+	std::vector<char> found(count);
+
+	// unsorted probes
+	size_t cnt = s.find_batch_pos(keys.begin(), keys.end(), pos.begin());
+	SEQ_TEST(s.contains_batch(keys.begin(), keys.end(), found.begin()) == cnt);
+	size_t expected = 0;
+	for (size_t i = 0; i < count; ++i) {
+		SEQ_TEST(pos[i] == s.find_pos(keys[i]));
+		SEQ_TEST((found[i] != 0) == s.contains(keys[i]));
+		expected += s.contains(keys[i]);
+	}
+	SEQ_TEST(cnt == expected);
+
+	// sorted probes
+	std::sort(keys.begin(), keys.end());
+	SEQ_TEST(s.find_batch_pos(keys.begin(), keys.end(), pos.begin()) == expected);
+	for (size_t i = 0; i < count; ++i)
+		SEQ_TEST(pos[i] == s.find_pos(keys[i]));
+
+	// sparse sorted probes
+	std::vector<key_type> sparse;
+	for (size_t i = 0; i < count; i += 97)
+		sparse.push_back(keys[i]);
+	std::vector<typename Set::const_iterator> its(sparse.size());
+	static_cast<const Set&>(s).find_batch(sparse.begin(), sparse.end(), its.begin());
+	for (size_t i = 0; i < sparse.size(); ++i)
+		SEQ_TEST(its[i] == static_cast<const Set&>(s).find(sparse[i]));
+}
+
+template<class T>
+void test_arithmetic_lower_bound(size_t count)
+{
+	// Check lower_bound on arithmetic keys (SIMD path) against std::lower_bound
+	std::vector<T> vals(count);
+	for (size_t i = 0; i < count; ++i)
+		vals[i] = static_cast<T>(i * 2);
+	seq::random_shuffle(vals.begin(), vals.end());
+
+	seq::flat_set<T> s;
+	for (size_t i = 0; i < count; ++i)
+		s.insert(vals[i]);
+	std::sort(vals.begin(), vals.end());
+
+	for (size_t i = 0; i < count * 2 + 1; ++i) {
+		T key = static_cast<T>(i);
+		size_t expected = static_cast<size_t>(std::lower_bound(vals.begin(), vals.end(), key) - vals.begin());
+		SEQ_TEST(s.lower_bound_pos(key) == expected);
+		SEQ_TEST(s.contains(key) == ((i & 1) == 0 && i < count * 2));
+	}
+}
+
+template<class T>
+void test_arithmetic_lower_bound_full_range(size_t count)
+{
+	// Random keys over the full integer range: exercises the sign handling of the SIMD compare
+	// (bias for unsigned keys, negative values for signed keys)
+	std::mt19937_64 rng(0);
+	std::vector<T> vals(count);
+	for (size_t i = 0; i < count; ++i)
+		vals[i] = static_cast<T>(rng());
+	vals.push_back(std::numeric_limits<T>::min());
+	vals.push_back(std::numeric_limits<T>::max());
+	vals.push_back(static_cast<T>(0));
+	vals.push_back(static_cast<T>(-1));
+
+	seq::flat_set<T> s(vals.begin(), vals.end());
+	std::sort(vals.begin(), vals.end());
+	vals.erase(std::unique(vals.begin(), vals.end()), vals.end());
+	SEQ_TEST(s.size() == vals.size());
+
+	std::vector<T> probes(vals.begin(), vals.end());
+	for (size_t i = 0; i < count; ++i)
+		probes.push_back(static_cast<T>(rng()));
+	probes.push_back(std::numeric_limits<T>::min() + 1);
+	probes.push_back(std::numeric_limits<T>::max() - 1);
+	probes.push_back(static_cast<T>(1));
+	probes.push_back(static_cast<T>(-2));
+
+	for (T key : probes) {
+		size_t expected = static_cast<size_t>(std::lower_bound(vals.begin(), vals.end(), key) - vals.begin());
+		SEQ_TEST(s.lower_bound_pos(key) == expected);
+		SEQ_TEST(s.contains(key) == std::binary_search(vals.begin(), vals.end(), key));
+	}
+}
+
+template<class Set>
+void test_set_operations(size_t count1, size_t count2, size_t modulo)
+{
+	using key_type = typename Set::key_type;
+	std::vector<key_type> v1, v2;
+	for (size_t i = 0; i < count1; ++i)
+		v1.push_back(static_cast<key_type>((i * 7) % modulo));
+	for (size_t i = 0; i < count2; ++i)
+		v2.push_back(static_cast<key_type>((i * 13) % modulo));
+
+	Set s1(v1.begin(), v1.end());
+	Set s2(v2.begin(), v2.end());
+	std::vector<key_type> sv1(s1.begin(), s1.end());
+	std::vector<key_type> sv2(s2.begin(), s2.end());
+
+	std::vector<key_type> expected;
+	std::set_union(sv1.begin(), sv1.end(), sv2.begin(), sv2.end(), std::back_inserter(expected));
+	SEQ_TEST(set_equals(s1.merge_union(s2), expected));
+
+	expected.clear();
+	std::set_intersection(sv1.begin(), sv1.end(), sv2.begin(), sv2.end(), std::back_inserter(expected));
+	SEQ_TEST(set_equals(s1.merge_intersection(s2), expected));
+	SEQ_TEST(set_equals(s2.merge_intersection(s1), expected));
+
+	expected.clear();
+	std::set_difference(sv1.begin(), sv1.end(), sv2.begin(), sv2.end(), std::back_inserter(expected));
+	SEQ_TEST(set_equals(s1.merge_difference(s2), expected));
+
+	expected.clear();
+	std::set_difference(sv2.begin(), sv2.end(), sv1.begin(), sv1.end(), std::back_inserter(expected));
+	SEQ_TEST(set_equals(s2.merge_difference(s1), expected));
+}
+
+inline void test_set_operations_mixed()
+{
+	// Unique containers combined with multi containers
+	{
+		seq::flat_set<int> s{ 1, 5 };
+		seq::flat_multiset<int> m{ 3, 3, 3 };
+		auto u = s.merge_union(m);
+		SEQ_TEST(set_equals(u, std::vector<int>{ 1, 3, 5 }));
+		SEQ_TEST(u.count(3) == 1);
+		SEQ_TEST(set_equals(m.merge_union(s), std::vector<int>{ 1, 3, 3, 3, 5 }));
+	}
+	std::vector<int> v1, v2;
+	for (int i = 0; i < 10000; ++i) {
+		v1.push_back((i * 7) % 3000);
+		v2.push_back((i * 13) % 5000);
+	}
+	seq::flat_set<int> s1(v1.begin(), v1.end());
+	seq::flat_multiset<int> m1(v1.begin(), v1.end());
+	seq::flat_multiset<int> m2(v2.begin(), v2.end());
+	std::vector<int> sv1(s1.begin(), s1.end());
+	std::vector<int> mv1(m1.begin(), m1.end());
+	std::vector<int> mv2(m2.begin(), m2.end());
+
+	std::vector<int> expected;
+	std::set<int> tmp(v1.begin(), v1.end());
+	tmp.insert(v2.begin(), v2.end());
+	expected.assign(tmp.begin(), tmp.end());
+	SEQ_TEST(set_equals(s1.merge_union(m2), expected));
+
+	expected.clear();
+	std::set_union(mv2.begin(), mv2.end(), sv1.begin(), sv1.end(), std::back_inserter(expected));
+	SEQ_TEST(set_equals(m2.merge_union(s1), expected));
+	expected.clear();
+	std::set_union(mv1.begin(), mv1.end(), mv2.begin(), mv2.end(), std::back_inserter(expected));
+	SEQ_TEST(set_equals(m1.merge_union(m2), expected));
+
+	expected.clear();
+	std::set_intersection(sv1.begin(), sv1.end(), mv2.begin(), mv2.end(), std::back_inserter(expected));
+	SEQ_TEST(set_equals(s1.merge_intersection(m2), expected));
+	expected.clear();
+	std::set_difference(sv1.begin(), sv1.end(), mv2.begin(), mv2.end(), std::back_inserter(expected));
+	SEQ_TEST(set_equals(s1.merge_difference(m2), expected));
+
+	// Same for maps
+	seq::flat_map<int, int> map{ { 1, 1 }, { 5, 5 } };
+	seq::flat_multimap<int, int> mmap{ { 3, 0 }, { 3, 1 }, { 3, 2 }, { 5, 6 } };
+	auto mu = map.merge_union(mmap);
+	SEQ_TEST(mu.size() == 3 && mu.count(3) == 1 && mu.at(3) == 0 && mu.at(5) == 5);
+}
+
+inline void test_map_join(size_t count1, size_t count2)
+{
+	seq::flat_map<size_t, size_t> m1;
+	seq::flat_map<size_t, std::string> m2;
+	for (size_t i = 0; i < count1; ++i)
+		m1.emplace(i * 3, i);
+	for (size_t i = 0; i < count2; ++i)
+		m2.emplace(i * 5, std::to_string(i));
+
+	std::map<size_t, size_t> expected;
+	for (const auto& v : m1)
+		if (m2.contains(v.first))
+			expected[v.first] = v.second;
+
+	std::map<size_t, size_t> joined;
+	m1.join(m2, [&](const auto& a, const auto& b) {
+		SEQ_TEST(a.first == b.first);
+		SEQ_TEST(b.second == std::to_string(b.first / 5));
+		joined[a.first] = a.second;
+	});
+	SEQ_TEST(map_equals(joined, expected));
+
+	auto inter = m1.merge_intersection(seq::flat_map<size_t, size_t>(expected.begin(), expected.end()));
+	SEQ_TEST(map_equals(inter, expected));
+}
 
 SEQ_PROTOTYPE(int test_flat_map(int, char*[]))
 {
@@ -966,6 +1187,31 @@ SEQ_PROTOTYPE(int test_flat_map(int, char*[]))
 	SEQ_TEST_MODULE_RETURN(flat_multiset, 1, test_flat_multiset_logic<double>(al));
 	SEQ_TEST(get_alloc_bytes(al) == 0);
 
+	// Test lower bound on arithmetic keys
+	SEQ_TEST_MODULE_RETURN(flat_set_lower_bound_int32, 1, test_arithmetic_lower_bound<int>(20000));
+	SEQ_TEST_MODULE_RETURN(flat_set_lower_bound_uint32, 1, test_arithmetic_lower_bound<unsigned>(20000));
+	SEQ_TEST_MODULE_RETURN(flat_set_lower_bound_int64, 1, test_arithmetic_lower_bound<std::int64_t>(20000));
+	SEQ_TEST_MODULE_RETURN(flat_set_lower_bound_uint64, 1, test_arithmetic_lower_bound<std::uint64_t>(20000));
+	SEQ_TEST_MODULE_RETURN(flat_set_lower_bound_float, 1, test_arithmetic_lower_bound<float>(20000));
+	SEQ_TEST_MODULE_RETURN(flat_set_lower_bound_double, 1, test_arithmetic_lower_bound<double>(20000));
+	SEQ_TEST_MODULE_RETURN(flat_set_lower_bound_int32_full, 1, test_arithmetic_lower_bound_full_range<int>(20000));
+	SEQ_TEST_MODULE_RETURN(flat_set_lower_bound_uint32_full, 1, test_arithmetic_lower_bound_full_range<unsigned>(20000));
+	SEQ_TEST_MODULE_RETURN(flat_set_lower_bound_int64_full, 1, test_arithmetic_lower_bound_full_range<std::int64_t>(20000));
+	SEQ_TEST_MODULE_RETURN(flat_set_lower_bound_uint64_full, 1, test_arithmetic_lower_bound_full_range<std::uint64_t>(20000));
+
+	// Test set operations and join
+	SEQ_TEST_MODULE_RETURN(flat_set_operations, 1, test_set_operations<seq::flat_set<int>>(10000, 10000, 30000));
+	SEQ_TEST_MODULE_RETURN(flat_set_operations_skewed, 1, test_set_operations<seq::flat_set<int>>(100000, 1000, 300000));
+	SEQ_TEST_MODULE_RETURN(flat_multiset_operations, 1, test_set_operations<seq::flat_multiset<int>>(10000, 1000, 500));
+	SEQ_TEST_MODULE_RETURN(flat_set_operations_mixed, 1, test_set_operations_mixed());
+	SEQ_TEST_MODULE_RETURN(flat_map_join, 1, test_map_join(100000, 1000));
+
+	// Test batch lookup
+	SEQ_TEST_MODULE_RETURN(flat_set_find_batch, 1, test_find_batch<seq::flat_set<size_t>>(100000, [](size_t i) { return i * 3; }));
+	SEQ_TEST_MODULE_RETURN(flat_multiset_find_batch, 1, test_find_batch<seq::flat_multiset<size_t>>(100000, [](size_t i) { return i / 4; }));
+	SEQ_TEST_MODULE_RETURN(flat_map_find_batch, 1, test_find_batch<seq::flat_map<double, double>>(100000, [](size_t i) { return static_cast<double>(i); }));
+	SEQ_TEST_MODULE_RETURN(flat_map_find_batch_string, 1, test_find_batch<seq::flat_map<seq::tstring, seq::tstring>>(20000, [](size_t i) { return seq::generate_random_string<seq::tstring>(14, true); }));
+
 	// Test various map.multimap functions and potential memory leak
 	SEQ_TEST_MODULE_RETURN(heavy_flat_set_destroy, 1, test_heavy_set<seq::flat_set<TestDestroy<size_t>>>(10000));
 	SEQ_TEST(TestDestroy<size_t>::count() == 0);
@@ -35,6 +35,12 @@
 #include <iostream>
 #include <algorithm>
 #include <random>
+#include <list>
+#include <execution>
+#include <map>
+#include <set>
+#include <cstring>
+#include <thread>
 
 
 
@@ -705,6 +711,75 @@ void test_heavy_set(size_t count)
 	SEQ_TEST(s.size() == 0);
 }
 
+template<class Hash>
+void test_lru_ordered_map(size_t capacity, size_t count)
+{
+	// Compare seq::lru_ordered_map against a std::list + std::unordered_map LRU
+	using lru_type = seq::lru_ordered_map<size_t, size_t, Hash>;
+	lru_type lru(capacity);
+	std::list<std::pair<size_t, size_t>> lst;
+	std::unordered_map<size_t, typename std::list<std::pair<size_t, size_t>>::iterator> index;
+
+	std::mt19937 rng(0);
+	for (size_t i = 0; i < count; ++i) {
+		size_t key = rng() % (capacity * 2);
+		unsigned op = rng() % 4;
+		auto found = index.find(key);
+		if (op == 0) {
+			// lookup
+			size_t* v = lru.get(key);
+			SEQ_TEST((v == nullptr) == (found == index.end()));
+			if (found != index.end()) {
+				SEQ_TEST(*v == found->second->second);
+				lst.splice(lst.end(), lst, found->second);
+			}
+		}
+		else if (op == 3 && found != index.end()) {
+			// erase
+			SEQ_TEST(lru.erase(key) == 1);
+			lst.erase(found->second);
+			index.erase(found);
+		}
+		else {
+			// insert or assign
+			lru.insert_or_assign(key, i);
+			if (found != index.end()) {
+				found->second->second = i;
+				lst.splice(lst.end(), lst, found->second);
+			}
+			else {
+				lst.emplace_back(key, i);
+				index[key] = std::prev(lst.end());
+				if (lst.size() > capacity) {
+					index.erase(lst.front().first);
+					lst.pop_front();
+				}
+			}
+		}
+		SEQ_TEST(lru.size() == lst.size());
+	}
+	SEQ_TEST(std::equal(lru.begin(), lru.end(), lst.begin(), lst.end()));
+	SEQ_TEST(lru.bytes() == lru.size() * sizeof(std::pair<size_t, size_t>));
+
+	// check that the hash table is still valid
+	for (const auto& v : lst)
+		SEQ_TEST(lru.peek(v.first) != lru.end() && lru.peek(v.first)->second == v.second);
+
+	// byte budget
+	lru.set_capacity(capacity, 10 * sizeof(std::pair<size_t, size_t>));
+	SEQ_TEST(lru.size() == 10);
+	SEQ_TEST(std::equal(lru.begin(), lru.end(), std::prev(lst.end(), 10), lst.end()));
+
+	// move_to_front / move_to_back on ordered_set
+	seq::ordered_set<size_t, Hash> set;
+	for (size_t i = 0; i < 200; ++i)
+		set.push_back(i);
+	set.move_to_front(set.find(100));
+	set.move_to_back(set.find(0));
+	SEQ_TEST(*set.begin() == 100 && *std::prev(set.end()) == 0);
+	for (size_t i = 0; i < 200; ++i)
+		SEQ_TEST(set.find(i) != set.end() && *set.find(i) == i);
+}
 
 #include "tests.hpp"
 
@@ -722,6 +797,177 @@ struct DummyHash
 };
 
 
+template<class T>
+const T& parallel_rehash_key(const T& v)
+{
+	return v;
+}
+template<class K, class V>
+const K& parallel_rehash_key(const std::pair<K, V>& v)
+{
+	return v.first;
+}
+
+/// @brief Compare parallel rehash with the sequential one after bulk inserting values (with duplicates) in the sequence
+template<class Set, class Gen>
+void test_parallel_rehash(size_t count, Gen gen)
+{
+	std::vector<typename Set::value_type> vals;
+	for (size_t i = 0; i < count; ++i)
+		vals.push_back(gen(i));
+
+	Set ref, set, set_seq;
+	for (const auto& v : vals) {
+		ref.sequence().insert(v);
+		set.sequence().insert(v);
+		set_seq.sequence().insert(v);
+	}
+	ref.rehash();
+	set.rehash(std::execution::par);
+	set_seq.rehash(std::execution::seq);
+
+	SEQ_TEST(ref.size() == set.size() && ref.size() == set_seq.size());
+	SEQ_TEST(std::equal(ref.begin(), ref.end(), set.begin(), set.end()));
+	SEQ_TEST(std::equal(ref.begin(), ref.end(), set_seq.begin(), set_seq.end()));
+	for (const auto& v : vals) {
+		SEQ_TEST(set.find(parallel_rehash_key(v)) != set.end());
+		SEQ_TEST(set_seq.find(parallel_rehash_key(v)) != set_seq.end());
+	}
+
+	// Grow the table, no duplicates to remove
+	set.rehash(std::execution::par, set.size() * 4);
+	SEQ_TEST(std::equal(ref.begin(), ref.end(), set.begin(), set.end()));
+	for (const auto& v : vals)
+		SEQ_TEST(set.find(parallel_rehash_key(v)) != set.end());
+
+	// The table is still usable
+	for (const auto& v : vals)
+		SEQ_TEST(set.erase(parallel_rehash_key(v)) == ref.erase(parallel_rehash_key(v)));
+	SEQ_TEST(set.size() == 0 && ref.size() == 0);
+	for (const auto& v : vals)
+		SEQ_TEST(set.insert(v).second == ref.insert(v).second);
+	SEQ_TEST(std::equal(ref.begin(), ref.end(), set.begin(), set.end()));
+}
+
+/// @brief Allocator adding a guard zone after each block, checked on deallocation
+template<class T>
+struct GuardAlloc
+{
+	using value_type = T;
+	static constexpr size_t guard = 64;
+	static constexpr unsigned char pattern = 0xAB;
+
+	GuardAlloc() noexcept {}
+	template<class U>
+	GuardAlloc(const GuardAlloc<U>&) noexcept
+	{
+	}
+	bool operator==(const GuardAlloc&) const noexcept { return true; }
+	bool operator!=(const GuardAlloc&) const noexcept { return false; }
+
+	static bool& overflow() noexcept
+	{
+		static bool f = false;
+		return f;
+	}
+	T* allocate(size_t n)
+	{
+		unsigned char* p = static_cast<unsigned char*>(std::malloc(n * sizeof(T) + guard));
+		if (!p)
+			throw std::bad_alloc();
+		std::memset(p + n * sizeof(T), pattern, guard);
+		return reinterpret_cast<T*>(p);
+	}
+	void deallocate(T* ptr, size_t n) noexcept
+	{
+		unsigned char* p = reinterpret_cast<unsigned char*>(ptr);
+		for (size_t i = 0; i < guard; ++i)
+			if (p[n * sizeof(T) + i] != pattern)
+				overflow() = true;
+		std::free(p);
+	}
+};
+
+inline void test_ordered_set_rehash_wrap(size_t count)
+{
+	// Rehashing a dirty set must keep robin hood displacement within the bucket array, including when it wraps around the last bucket
+	using set_type = seq::ordered_set<size_t, seq::hasher<size_t>, std::equal_to<>, GuardAlloc<size_t>>;
+	for (size_t i = 0; i < count; ++i) {
+		set_type set;
+		std::set<size_t> ref;
+		size_t size = 1 + (i % 32);
+		for (size_t j = 0; j < size; ++j) {
+			set.insert(i + j * count);
+			ref.insert(i + j * count);
+		}
+		for (size_t j = 0; j < size; j += 2) {
+			set.erase(i + j * count);
+			ref.erase(i + j * count);
+		}
+		for (size_t j = 0; j < size; j += 4) {
+			set.insert(i + (j + size) * count);
+			ref.insert(i + (j + size) * count);
+		}
+		set.shrink_to_fit();
+		SEQ_TEST(set.size() == ref.size());
+		for (size_t v : ref)
+			SEQ_TEST(set.find(v) != set.end());
+	}
+	SEQ_TEST(!GuardAlloc<size_t>::overflow());
+}
+
+template<class Map>
+void test_chunk_pool_small_maps(size_t threads, size_t maps, size_t max_size)
+{
+	// Build many small maps sharing the chunk pool from several threads, erase half of each map and check them.
+	// Running the same workload twice must reuse the pool memory (thread caches might slightly change the peak footprint).
+	auto work = [&](size_t seed) {
+		std::vector<Map> vec(maps);
+		std::vector<std::map<size_t, size_t>> ref(maps);
+		bool ok = true;
+		for (size_t i = 0; i < maps; ++i) {
+			size_t size = (i * 7 + seed) % max_size;
+			for (size_t j = 0; j < size; ++j) {
+				vec[i].emplace(j * 13, j);
+				ref[i].emplace(j * 13, j);
+			}
+			for (size_t j = 0; j < size; j += 2) {
+				vec[i].erase(j * 13);
+				ref[i].erase(j * 13);
+			}
+		}
+		for (size_t i = 0; i < maps; ++i) {
+			ok = ok && vec[i].size() == ref[i].size();
+			for (auto& p : ref[i]) {
+				auto it = vec[i].find(p.first);
+				ok = ok && it != vec[i].end() && it->second == p.second;
+			}
+			vec[i].shrink_to_fit();
+		}
+		return ok;
+	};
+	auto run = [&]() {
+		std::vector<std::thread> th;
+		std::vector<char> ok(threads, 0);
+		for (size_t t = 0; t < threads; ++t)
+			th.emplace_back([&, t]() { ok[t] = work(t); });
+		for (auto& t : th)
+			t.join();
+		return std::all_of(ok.begin(), ok.end(), [](char c) { return c != 0; });
+	};
+	SEQ_TEST(run());
+	size_t footprint = seq::chunk_pool_memory_footprint();
+	SEQ_TEST(footprint > 0);
+	SEQ_TEST(run());
+	SEQ_TEST(seq::chunk_pool_memory_footprint() <= footprint + footprint / 4);
+}
+
+/// @brief Hash function sending 1/64 of the keys to the same bucket
+struct CollideHash
+{
+	size_t operator()(size_t v) const noexcept { return (v & 63U) == 0 ? 0 : seq::hasher<size_t>{}(v); }
+};
+
 
 SEQ_PROTOTYPE( int test_ordered_map(int , char*[]))
 { 
@@ -745,5 +991,21 @@ SEQ_PROTOTYPE( int test_ordered_map(int , char*[]))
 	SEQ_TEST(TestDestroy<double>::count() == 0);
 	SEQ_TEST(get_alloc_bytes(al2) == 0);
 
+	// Test rehash of small dirty sets
+	SEQ_TEST_MODULE_RETURN(ordered_set_rehash_wrap, 1, test_ordered_set_rehash_wrap(20000));
+
+	// Test the shared chunk pool
+	SEQ_TEST_MODULE_RETURN(ordered_set_chunk_pool, 1, test_ordered_set_logic<double>(seq::chunk_pool_allocator<double>()));
+	SEQ_TEST_MODULE_RETURN(ordered_map_chunk_pool_threads, 1, test_chunk_pool_small_maps<seq::ordered_map<size_t, size_t, seq::hasher<size_t>, std::equal_to<>, seq::chunk_pool_allocator<std::pair<size_t, size_t>>>>(4, 20000, 40));
+
+	// Test LRU mode
+	SEQ_TEST_MODULE_RETURN(lru_ordered_map, 1, test_lru_ordered_map<seq::hasher<size_t>>(1000, 200000));
+	SEQ_TEST_MODULE_RETURN(lru_ordered_map_linear, 1, test_lru_ordered_map<DummyHash>(100, 20000));
+
+	// Test parallel rehash
+	SEQ_TEST_MODULE_RETURN(parallel_rehash, 1, test_parallel_rehash<seq::ordered_set<size_t>>(300000, [](size_t i) { return (i * UINT64_C(0xc4ceb9fe1a85ec53)) % 200000U; }));
+	SEQ_TEST_MODULE_RETURN(parallel_rehash_map, 1, test_parallel_rehash<seq::ordered_map<std::string, size_t>>(100000, [](size_t i) { return std::make_pair(std::to_string(i % 70000U), i); }));
+	SEQ_TEST_MODULE_RETURN(parallel_rehash_collide, 1, test_parallel_rehash<seq::ordered_set<size_t, CollideHash>>(100000, [](size_t i) { return i % 80000U; }));
+
 	return 0;
 }
@@ -29,6 +29,8 @@
 #include <list>
 #include <vector>
 #include <deque>
+#include <random>
+#include <algorithm>
 
 template<class Alloc, class U>
 using RebindAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<U>;
@@ -482,6 +484,109 @@ void test_sequence(unsigned size = 50000000U, const Alloc& al = Alloc())
 	SEQ_TEST(equal_seq(deq, seq) && seq.size() > 0 && seq2.size() == 0 && deq2.size() == 0);
 }
 
+template<class T>
+void test_sequence_capacity()
+{
+	// capacity() must count the actual number of slots per chunk, which depends on sizeof(T)
+	constexpr size_t count = seq::detail::list_chunk<T>::count;
+	seq::sequence<T> seq;
+	SEQ_TEST(seq.capacity() == 0);
+	for (size_t i = 0; i < count * 10 + 1; ++i) {
+		seq.push_back(T(i));
+		SEQ_TEST(seq.capacity() == ((seq.size() + count - 1) / count) * count);
+	}
+}
+
+template<class T>
+void test_sequence_compact_step(size_t size)
+{
+	// Erase most values, then compact the sequence step by step.
+	// Order must be preserved, and each step must respect the move budget and report each move.
+	constexpr size_t count = seq::detail::list_chunk<T>::count;
+	seq::sequence<T> seq;
+	std::deque<T> deq;
+	for (size_t i = 0; i < size; ++i) {
+		seq.push_back(T(i));
+		deq.push_back(T(i));
+	}
+	std::mt19937 rng(0);
+	for (auto it = seq.begin(); it != seq.end();) {
+		// erase whole chunks, and random values
+		size_t v = static_cast<size_t>(*it);
+		if ((v / count) % 7 == 3 || rng() % 4 != 0)
+			it = seq.erase(it);
+		else
+			++it;
+	}
+	deq.assign(seq.begin(), seq.end());
+	const size_t capacity = seq.capacity();
+
+	size_t steps = 0, moves = 0;
+	for (;;) {
+		size_t reported = 0;
+		bool ok = true;
+		size_t m = seq.compact_step(37, [&](typename seq::sequence<T>::const_iterator, typename seq::sequence<T>::iterator to) {
+			ok = ok && static_cast<size_t>(*to) < size;
+			++reported;
+		});
+		SEQ_TEST(ok && m <= 37 && m == reported);
+		if (m == 0)
+			break;
+		moves += m;
+		if (++steps % 16 == 0)
+			SEQ_TEST(equal_seq(seq, deq));
+	}
+	SEQ_TEST(moves > 0);
+	SEQ_TEST(equal_seq(seq, deq));
+	SEQ_TEST(seq.capacity() < capacity);
+	// every pair of adjacent chunks holds more than count values
+	SEQ_TEST(seq.capacity() < 2 * seq.size() + 2 * count);
+	SEQ_TEST(seq.compact_step(100) == 0);
+
+	// The sequence must remain usable
+	for (size_t i = 0; i < size / 2; ++i) {
+		seq.insert(T(i + size));
+		deq.push_back(T(i + size));
+	}
+	for (size_t i = 0; i < size / 8; ++i) {
+		seq.push_front(T(i + 2 * size));
+		deq.push_front(T(i + 2 * size));
+	}
+	std::vector<size_t> v1, v2;
+	for (const auto& v : seq)
+		v1.push_back(static_cast<size_t>(v));
+	for (const auto& v : deq)
+		v2.push_back(static_cast<size_t>(v));
+	std::sort(v1.begin(), v1.end());
+	std::sort(v2.begin(), v2.end());
+	SEQ_TEST(v1 == v2);
+}
+
+template<class T>
+void test_sequence_sort_chunk_boundary()
+{
+	// Sorting a sequence with holes whose size is a multiple of the chunk size:
+	// compacting the values ends exactly on a chunk boundary and frees the following chunks.
+	constexpr size_t count = seq::detail::list_chunk<T>::count;
+	for (size_t chunks = 1; chunks < 8; ++chunks) {
+		seq::sequence<T> seq;
+		std::deque<T> deq;
+		for (size_t i = 0; i < chunks * count * 2; ++i)
+			seq.push_back(T(chunks * count * 2 - i));
+		// erase one value out of two
+		auto it = seq.begin();
+		while (it != seq.end()) {
+			it = seq.erase(it);
+			deq.push_back(*it);
+			++it;
+		}
+		SEQ_TEST(seq.size() == chunks * count);
+		seq.sort();
+		std::sort(deq.begin(), deq.end());
+		SEQ_TEST(equal_seq(seq, deq));
+	}
+}
+
 SEQ_PROTOTYPE(int test_sequence(int, char*[]))
 {
 	// Test sequence and detect potential memory leak or wrong allocator propagation
@@ -493,5 +598,16 @@ SEQ_PROTOTYPE(int test_sequence(int, char*[]))
 	SEQ_TEST_MODULE_RETURN(sequence_destroy, 1, test_sequence<TestDestroy<size_t>>(1000000));
 	SEQ_TEST(TestDestroy<size_t>::count() == 0);
 
+	SEQ_TEST_MODULE_RETURN(sequence_sort_chunk_boundary, 1, test_sequence_sort_chunk_boundary<size_t>(); test_sequence_sort_chunk_boundary<WideType>());
+
+	SEQ_TEST_MODULE_RETURN(sequence_capacity, 1, test_sequence_capacity<size_t>(); test_sequence_capacity<WideType>());
+
+	SEQ_TEST_MODULE_RETURN(sequence_compact_step, 1, test_sequence_compact_step<size_t>(100000); test_sequence_compact_step<WideType>(30000));
+	SEQ_TEST_MODULE_RETURN(sequence_compact_step_destroy, 1, test_sequence_compact_step<TestDestroy<size_t>>(30000));
+	SEQ_TEST(TestDestroy<size_t>::count() == 0);
+
+	// Test sequence with the shared chunk pool
+	SEQ_TEST_MODULE_RETURN(sequence_chunk_pool, 1, test_sequence<size_t>(300000, seq::chunk_pool_allocator<size_t>()));
+
 	return 0;
 }
@@ -6,6 +6,7 @@
 #include <type_traits>
 
 #include <seq/type_traits.hpp>
+#include <seq/chunk_pool.hpp>
 
 
 namespace test_detail
@@ -189,5 +190,10 @@ std::int64_t get_alloc_bytes(const std::allocator<T>& )
 {
 	return 0;
 }
+template<class T>
+std::int64_t get_alloc_bytes(const seq::chunk_pool_allocator<T>& )
+{
+	return 0;
+}
 
 #endif